@@ -1,6 +1,9 @@
 #ifndef SUMIRE_BASIC_COMPLETER_IN_H
 #define SUMIRE_BASIC_COMPLETER_IN_H
 
+#include "var-int-reader.h"
+#include "var-int-writer.h"
+
 #include <cassert>
 
 namespace sumire {
@@ -15,6 +18,7 @@ inline bool BasicCompleter::start(const TrieBase &trie, UInt32 index)
 	clear();
 
 	trie_ = &trie;
+	index_ = index;
 	key_.push_back('\0');
 	index_stack_.push_back(index);
 
@@ -31,7 +35,10 @@ inline bool BasicCompleter::next()
 	if (value_ != TrieBase::INVALID_VALUE)
 	{
 		if (!find_next())
+		{
+			index_stack_.clear();
 			return false;
+		}
 	}
 
 	return find_value();
@@ -44,14 +51,97 @@ inline const char *BasicCompleter::key() const
 	return reinterpret_cast<const char *>(&key_[0]);
 }
 
+// The state is the start node and the current key, and the path to the
+// current key is found again by resume().
+inline bool BasicCompleter::save(std::ostream *output) const
+{
+	assert(trie_ != NULL);
+	assert(output != NULL);
+
+	State state = STARTED_STATE;
+	if (index_stack_.empty())
+		state = FINISHED_STATE;
+	else if (value_ == TrieBase::INVALID_VALUE)
+		state = NOT_STARTED_STATE;
+
+	VarIntWriter writer(output);
+	if (!writer.write(index_) || !writer.write(state))
+		return false;
+	if (state != STARTED_STATE)
+		return true;
+
+	if (!writer.write(length()))
+		return false;
+	for (UInt32 i = 0; i < length(); ++i)
+	{
+		if (!writer.write(key_[i]))
+			return false;
+	}
+	return true;
+}
+
+inline bool BasicCompleter::resume(const TrieBase &trie, std::istream *input)
+{
+	assert(input != NULL);
+
+	clear();
+
+	VarIntReader reader(input);
+	UInt32 index, state;
+	if (!reader.read(&index) || !reader.read(&state))
+		return resume_failed();
+	if (index >= trie.num_units() || !start(trie, index))
+		return resume_failed();
+
+	switch (state)
+	{
+	case NOT_STARTED_STATE:
+		return true;
+	case FINISHED_STATE:
+		index_stack_.clear();
+		return true;
+	case STARTED_STATE:
+		break;
+	default:
+		return resume_failed();
+	}
+
+	UInt32 key_length;
+	if (!reader.read(&key_length))
+		return resume_failed();
+	for (UInt32 i = 0; i < key_length; ++i)
+	{
+		UInt32 label;
+		if (!reader.read(&label) || label == 0 || label > UInt8Limits::max())
+			return resume_failed();
+
+		UInt32 child_index = trie.find_child(index_stack_.back(),
+			static_cast<UInt8>(label));
+		if (child_index == 0)
+			return resume_failed();
+		push_index(child_index);
+	}
+
+	if (!trie.get_value(index_stack_.back(), &value_))
+		return resume_failed();
+	return true;
+}
+
 inline void BasicCompleter::clear()
 {
 	trie_ = NULL;
+	index_ = 0;
 	key_.clear();
 	index_stack_.clear();
 	value_ = TrieBase::INVALID_VALUE;
 }
 
+inline bool BasicCompleter::resume_failed()
+{
+	clear();
+	return false;
+}
+
 inline bool BasicCompleter::find_next()
 {
 	assert(index_stack_.size() > 0);
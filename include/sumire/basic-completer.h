@@ -10,7 +10,8 @@ namespace sumire {
 class BasicCompleter : public CompleterBase
 {
 public:
-	BasicCompleter() : trie_(NULL), key_(), index_stack_(), value_(0) {}
+	BasicCompleter() : trie_(NULL), index_(0), key_(), index_stack_(),
+		value_(0) {}
 	~BasicCompleter() { clear(); }
 
 	bool start(const TrieBase &trie, UInt32 index);
@@ -20,10 +21,16 @@ public:
 	UInt32 length() const { return key_.size() - 1; }
 	UInt32 value() const { return value_; }
 
+	// Saves the state of enumeration so that resume() continues it later
+	// on the same trie, possibly in another process.
+	bool save(std::ostream *output) const;
+	bool resume(const TrieBase &trie, std::istream *input);
+
 	void clear();
 
 private:
 	const TrieBase *trie_;
+	UInt32 index_;
 	std::vector<UInt8> key_;
 	std::vector<UInt32> index_stack_;
 	UInt32 value_;
@@ -32,6 +39,15 @@ private:
 	BasicCompleter(const BasicCompleter &);
 	BasicCompleter &operator=(const BasicCompleter &);
 
+	enum State
+	{
+		NOT_STARTED_STATE,
+		STARTED_STATE,
+		FINISHED_STATE
+	};
+
+	bool resume_failed();
+
 	bool find_next();
 	bool find_value();
 
@@ -2,8 +2,10 @@
 #define SUMIRE_BASIC_SUCCINCT_BIT_VECTOR_IN_H
 
 #include "object-io.h"
-#include "select-table.h"
+#include "pop-count.h"
+#include "word-select.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace sumire {
@@ -40,46 +42,110 @@ inline UInt32 BasicSuccinctBitVector::Block::local_rank(UInt32 local_id) const
 
 inline void BasicSuccinctBitVector::build(const BitVector &bv)
 {
-	UInt32 num_blocks = (bv.num_units() + UNITS_PER_BLOCK - 1)
-		/ UNITS_PER_BLOCK;
+	if (bv.is_contiguous())
+	{
+		build(bv.units(), bv.num_bits());
+		return;
+	}
 
-	ObjectArray<Block> blocks;
-	blocks.resize(num_blocks);
 	ObjectArray<UInt32> units;
-	units.resize(bv.num_units());
+	units.resize((bv.num_bits() + BITS_PER_UNIT - 1) / BITS_PER_UNIT);
+	for (UInt32 unit_id = 0; unit_id < units.num_objs(); ++unit_id)
+		units[unit_id] = bv.unit(unit_id);
 
-	UInt32 num_ones = 0;
-	for (UInt32 unit_id = 0; unit_id < bv.num_units(); ++unit_id)
+	build(&units, bv.num_bits());
+}
+
+// This function takes over the units of a contiguous bit vector, and then
+// *bv gets empty.
+inline void BasicSuccinctBitVector::build(BitVector *bv)
+{
+	assert(bv != NULL);
+
+	if (!bv->is_contiguous())
 	{
-		units[unit_id] = bv.unit(unit_id);
+		build(*bv);
+		bv->clear();
+		return;
+	}
+
+	UInt32 num_bits = bv->num_bits();
+	ObjectArray<UInt32> units;
+	bv->release(&units);
+	build(&units, num_bits);
+}
+
+inline void BasicSuccinctBitVector::build(
+	const UInt32 *units_ptr, UInt32 num_bits)
+{
+	assert(units_ptr != NULL || num_bits == 0);
 
-		UInt32 block_id = unit_id / UNITS_PER_BLOCK;
-		UInt32 local_id = unit_id % UNITS_PER_BLOCK;
+	ObjectArray<UInt32> units;
+	units.resize((num_bits + BITS_PER_UNIT - 1) / BITS_PER_UNIT);
+	std::copy(units_ptr, units_ptr + units.num_objs(), units.begin());
 
-		blocks[block_id].set_rank(local_id, num_ones);
+	build(&units, num_bits);
+}
 
-		UInt32 left_bits = bv.num_bits() - unit_id * BITS_PER_UNIT;
-		UInt32 left_shift = 0;
-		if (left_bits < BITS_PER_UNIT)
-			left_shift = BITS_PER_UNIT - left_bits;
+// This function takes over the units, so *units_ptr gets empty.
+inline void BasicSuccinctBitVector::build(
+	ObjectArray<UInt32> *units_ptr, UInt32 num_bits)
+{
+	assert(units_ptr != NULL);
+	assert(units_ptr->num_objs() ==
+		(num_bits + BITS_PER_UNIT - 1) / BITS_PER_UNIT);
 
-		num_ones += pop_count(bv.unit(unit_id) << left_shift) >> 24;
-	}
+	ObjectArray<UInt32> units;
+	units.swap(units_ptr);
+
+	UInt32 num_units = units.num_objs();
+	UInt32 num_blocks = (num_units + UNITS_PER_BLOCK - 1) / UNITS_PER_BLOCK;
+
+	ObjectArray<Block> blocks;
+	blocks.resize(num_blocks);
 
-	for (UInt32 unit_id = bv.num_units();
-		unit_id < num_blocks * UNITS_PER_BLOCK; ++unit_id)
+	// The first pass fills local ranks, which do not depend on the other
+	// blocks, and keeps the number of 1s in each block as its global rank.
+	// The second pass converts the numbers into global ranks. It reads one
+	// word per block, so it is left serial.
+#ifdef _OPENMP
+#pragma omp parallel for if (num_blocks >= MIN_PARALLEL_NUM_BLOCKS)
+#endif  // _OPENMP
+	for (UInt32 block_id = 0; block_id < num_blocks; ++block_id)
 	{
-		UInt32 block_id = unit_id / UNITS_PER_BLOCK;
-		UInt32 local_id = unit_id % UNITS_PER_BLOCK;
+		UInt8 counts[UNITS_PER_BLOCK];
+		count_block(units, num_bits, block_id, counts);
+
+		Block &block = blocks[block_id];
+		UInt32 rank = 0;
+		for (UInt32 local_id = 1; local_id < UNITS_PER_BLOCK; ++local_id)
+		{
+			UInt32 unit_id = (block_id * UNITS_PER_BLOCK) + local_id;
+			if (unit_id < num_units)
+				rank += counts[local_id - 1];
+			else
+				rank = BITS_PER_BLOCK - 1;
+			block.set_rank(local_id, rank);
+		}
+
+		UInt32 count = 0;
+		for (UInt32 local_id = 0; local_id < UNITS_PER_BLOCK; ++local_id)
+			count += counts[local_id];
+		block.set_rank(0, count);
+	}
 
-		blocks[block_id].set_rank(local_id,
-			blocks[block_id].rank(0) + BITS_PER_BLOCK - 1);
+	UInt32 num_ones = 0;
+	for (UInt32 block_id = 0; block_id < num_blocks; ++block_id)
+	{
+		UInt32 count = blocks[block_id].global_rank();
+		blocks[block_id].set_rank(0, num_ones);
+		num_ones += count;
 	}
 
 	clear();
 	blocks_.swap(&blocks);
 	units_.swap(&units);
-	num_bits_ = bv.num_bits();
+	num_bits_ = num_bits;
 	num_ones_ = num_ones;
 }
 
@@ -103,50 +169,59 @@ inline UInt32 BasicSuccinctBitVector::rank_0(UInt32 index) const
 	return index - rank_1(index) + 1;
 }
 
-inline UInt32 BasicSuccinctBitVector::select_1(UInt32 count) const
+inline void BasicSuccinctBitVector::rank_1(const UInt32 *indices,
+	UInt32 num_indices, UInt32 *ranks) const
 {
-	assert(count > 0);
-	assert(count <= num_ones());
-
-	UInt32 left = 0;
-	UInt32 right = num_blocks();
-	while (left + 1 < right)
+	assert(indices != NULL || num_indices == 0);
+	assert(ranks != NULL || num_indices == 0);
+
+	// Indices in the same unit share the rank of the unit.
+	UInt32 unit_id = UInt32Limits::max();
+	UInt32 unit = 0;
+	UInt32 unit_rank = 0;
+	for (UInt32 i = 0; i < num_indices; ++i)
 	{
-		UInt32 middle = (left + right) / 2;
-		if (blocks_[middle].global_rank() >= count)
-			right = middle;
-		else
-			left = middle;
+		assert(indices[i] < num_bits());
+		assert((i == 0) || (indices[i - 1] <= indices[i]));
+
+#ifdef __GNUC__
+		if (i + PREFETCH_DISTANCE < num_indices)
+		{
+			UInt32 next_unit_id =
+				indices[i + PREFETCH_DISTANCE] / BITS_PER_UNIT;
+			__builtin_prefetch(&units_[next_unit_id]);
+			__builtin_prefetch(&blocks_[next_unit_id / UNITS_PER_BLOCK]);
+		}
+#endif  // __GNUC__
+
+		if (indices[i] / BITS_PER_UNIT != unit_id)
+		{
+			unit_id = indices[i] / BITS_PER_UNIT;
+			unit = units_[unit_id];
+			unit_rank = blocks_[unit_id / UNITS_PER_BLOCK].rank(
+				unit_id % UNITS_PER_BLOCK);
+		}
+
+		UInt32 bit_id = indices[i] % BITS_PER_UNIT;
+		ranks[i] = unit_rank + (pop_count(unit &
+			(~UNIT_0 >> (BITS_PER_UNIT - bit_id - 1))) >> 24);
 	}
-	UInt32 global_id = left;
-	count -= blocks_[global_id].global_rank();
-
-	UInt32 local_id = 1;
-	for ( ; local_id < UNITS_PER_BLOCK; ++local_id)
-	{
-		if (blocks_[global_id].local_rank(local_id) >= count)
-			break;
-	}
-	--local_id;
-	count -= blocks_[global_id].local_rank(local_id);
-
-	UInt32 index = (global_id * BITS_PER_BLOCK) + (local_id * BITS_PER_UNIT);
-	UInt32 unit = units_[index / BITS_PER_UNIT];
-	UInt32 bytes = pop_count(unit);
-
-	UInt64 offset = 0;
-	if (count <= ((bytes << 16) >> 24))
-		offset += 16;
-	if (count <= ((bytes << (offset + 8)) >> 24))
-		offset += 8;
+}
 
-	count -= ((bytes << offset) << 8) >> 24;
-	unit >>= BITS_PER_UNIT - (offset + 8);
-	index += BITS_PER_UNIT - (offset + 8);
+inline void BasicSuccinctBitVector::rank_0(const UInt32 *indices,
+	UInt32 num_indices, UInt32 *ranks) const
+{
+	rank_1(indices, num_indices, ranks);
+	for (UInt32 i = 0; i < num_indices; ++i)
+		ranks[i] = indices[i] - ranks[i] + 1;
+}
 
-	index += SelectTable::lookup(true, count, unit);
+inline UInt32 BasicSuccinctBitVector::select_1(UInt32 count) const
+{
+	assert(count > 0);
+	assert(count <= num_ones());
 
-	return index - 1;
+	return select_1_in_block(search_block_1(0, num_blocks(), count), count);
 }
 
 inline UInt32 BasicSuccinctBitVector::select_0(UInt32 count) const
@@ -154,48 +229,76 @@ inline UInt32 BasicSuccinctBitVector::select_0(UInt32 count) const
 	assert(count > 0);
 	assert(count <= num_zeros());
 
-	UInt32 left = 0;
-	UInt32 right = num_blocks();
-	while (left + 1 < right)
-	{
-		UInt32 middle = (left + right) / 2;
-		if (middle * BITS_PER_BLOCK - blocks_[middle].global_rank() >= count)
-			right = middle;
-		else
-			left = middle;
-	}
-	UInt32 global_id = left;
-	count -= left * BITS_PER_BLOCK - blocks_[left].global_rank();
+	return select_0_in_block(search_block_0(0, num_blocks(), count), count);
+}
 
-	UInt32 local_id = 1;
-	for ( ; local_id < UNITS_PER_BLOCK; ++local_id)
+inline void BasicSuccinctBitVector::select_1(const UInt32 *counts,
+	UInt32 num_counts, UInt32 *indices) const
+{
+	assert(counts != NULL || num_counts == 0);
+	assert(indices != NULL || num_counts == 0);
+
+	// The search for each count starts from the block of the previous one
+	// and gallops forward.
+	UInt32 block_id = 0;
+	for (UInt32 i = 0; i < num_counts; ++i)
 	{
-		UInt32 local_rank = local_id * BITS_PER_UNIT
-			- blocks_[global_id].local_rank(local_id);
-		if (local_rank >= count)
-			break;
+		assert(counts[i] > 0);
+		assert(counts[i] <= num_ones());
+		assert((i == 0) || (counts[i - 1] <= counts[i]));
+
+		UInt32 left = block_id;
+		UInt32 right = block_id + 1;
+		for (UInt32 step = 1; (right < num_blocks()) &&
+			(blocks_[right].global_rank() < counts[i]); step *= 2)
+		{
+			left = right;
+			right = (num_blocks() - right > step) ?
+				(right + step) : num_blocks();
+		}
+		block_id = search_block_1(left, right, counts[i]);
+
+#ifdef __GNUC__
+		if (block_id + 1 < num_blocks())
+			__builtin_prefetch(&blocks_[block_id + 1]);
+#endif  // __GNUC__
+
+		indices[i] = select_1_in_block(block_id, counts[i]);
 	}
-	--local_id;
-	count -= local_id * BITS_PER_UNIT
-		- blocks_[global_id].local_rank(local_id);
-
-	UInt32 index = (global_id * BITS_PER_BLOCK) + (local_id * BITS_PER_UNIT);
-	UInt32 unit = units_[index / BITS_PER_UNIT];
-	UInt32 bytes = pop_count(~unit);
-
-	UInt64 offset = 0;
-	if (count <= ((bytes << 16) >> 24))
-		offset += 16;
-	if (count <= ((bytes << (offset + 8)) >> 24))
-		offset += 8;
-
-	count -= ((bytes << offset) << 8) >> 24;
-	unit >>= BITS_PER_UNIT - (offset + 8);
-	index += BITS_PER_UNIT - (offset + 8);
+}
 
-	index += SelectTable::lookup(false, count, unit);
+inline void BasicSuccinctBitVector::select_0(const UInt32 *counts,
+	UInt32 num_counts, UInt32 *indices) const
+{
+	assert(counts != NULL || num_counts == 0);
+	assert(indices != NULL || num_counts == 0);
 
-	return index - 1;
+	UInt32 block_id = 0;
+	for (UInt32 i = 0; i < num_counts; ++i)
+	{
+		assert(counts[i] > 0);
+		assert(counts[i] <= num_zeros());
+		assert((i == 0) || (counts[i - 1] <= counts[i]));
+
+		UInt32 left = block_id;
+		UInt32 right = block_id + 1;
+		for (UInt32 step = 1; (right < num_blocks()) && ((right
+			* BITS_PER_BLOCK) - blocks_[right].global_rank() < counts[i]);
+			step *= 2)
+		{
+			left = right;
+			right = (num_blocks() - right > step) ?
+				(right + step) : num_blocks();
+		}
+		block_id = search_block_0(left, right, counts[i]);
+
+#ifdef __GNUC__
+		if (block_id + 1 < num_blocks())
+			__builtin_prefetch(&blocks_[block_id + 1]);
+#endif  // __GNUC__
+
+		indices[i] = select_0_in_block(block_id, counts[i]);
+	}
 }
 
 inline bool BasicSuccinctBitVector::operator[](UInt32 index) const
@@ -218,6 +321,36 @@ inline bool BasicSuccinctBitVector::get(UInt32 index) const
 	return (units_[unit_id] & (UNIT_1 << bit_id)) != 0;
 }
 
+inline UInt32 BasicSuccinctBitVector::unit(UInt32 unit_id) const
+{
+	assert(unit_id < num_units());
+
+	return units_[unit_id];
+}
+
+inline UInt32 BasicSuccinctBitVector::run_length_1(UInt32 index) const
+{
+	assert(index < num_bits());
+
+	// The run is measured in units and clipped at the end because the bits
+	// after the last bit are undefined.
+	UInt32 unit_id = index / BITS_PER_UNIT;
+	UInt32 bit_id = index % BITS_PER_UNIT;
+	UInt32 zeros = ~unit(unit_id) >> bit_id;
+
+	UInt32 num_ones = 0;
+	while (zeros == 0)
+	{
+		num_ones += BITS_PER_UNIT - bit_id;
+		if (++unit_id == num_units())
+			return num_bits() - index;
+		bit_id = 0;
+		zeros = ~unit(unit_id);
+	}
+	num_ones += PopCount::count(~zeros & (zeros - 1));
+	return std::min(num_ones, num_bits() - index);
+}
+
 inline void BasicSuccinctBitVector::clear()
 {
 	blocks_.clear();
@@ -294,6 +427,98 @@ inline void BasicSuccinctBitVector::swap(BasicSuccinctBitVector *target)
 	std::swap(num_ones_, target->num_ones_);
 }
 
+inline void BasicSuccinctBitVector::count_block(
+	const ObjectArray<UInt32> &units, UInt32 num_bits,
+	UInt32 block_id, UInt8 *counts)
+{
+	assert(block_id * UNITS_PER_BLOCK < units.num_objs());
+
+	UInt32 begin = block_id * UNITS_PER_BLOCK;
+	UInt32 end = begin + UNITS_PER_BLOCK;
+	if (end > units.num_objs())
+		end = units.num_objs();
+
+	PopCount::count_units(units.begin() + begin, end - begin, counts);
+	for (UInt32 local_id = end - begin; local_id < UNITS_PER_BLOCK; ++local_id)
+		counts[local_id] = 0;
+
+	// Bits after the end of the bit vector must not be counted.
+	if (end == units.num_objs() && (num_bits % BITS_PER_UNIT) != 0)
+	{
+		UInt32 mask = ~UNIT_0 >> (BITS_PER_UNIT - (num_bits % BITS_PER_UNIT));
+		counts[end - begin - 1] = PopCount::count(units[end - 1] & mask);
+	}
+}
+
+// Returns the last block in [left, right) whose global rank is less than
+// count. The global rank of left must be less than count.
+inline UInt32 BasicSuccinctBitVector::search_block_1(
+	UInt32 left, UInt32 right, UInt32 count) const
+{
+	while (left + 1 < right)
+	{
+		UInt32 middle = (left + right) / 2;
+		if (blocks_[middle].global_rank() >= count)
+			right = middle;
+		else
+			left = middle;
+	}
+	return left;
+}
+
+inline UInt32 BasicSuccinctBitVector::search_block_0(
+	UInt32 left, UInt32 right, UInt32 count) const
+{
+	while (left + 1 < right)
+	{
+		UInt32 middle = (left + right) / 2;
+		if (middle * BITS_PER_BLOCK - blocks_[middle].global_rank() >= count)
+			right = middle;
+		else
+			left = middle;
+	}
+	return left;
+}
+
+inline UInt32 BasicSuccinctBitVector::select_1_in_block(
+	UInt32 global_id, UInt32 count) const
+{
+	count -= blocks_[global_id].global_rank();
+
+	UInt32 local_id = 1;
+	for ( ; local_id < UNITS_PER_BLOCK; ++local_id)
+	{
+		if (blocks_[global_id].local_rank(local_id) >= count)
+			break;
+	}
+	--local_id;
+	count -= blocks_[global_id].local_rank(local_id);
+
+	UInt32 index = (global_id * BITS_PER_BLOCK) + (local_id * BITS_PER_UNIT);
+	return index + WordSelect::select_1(units_[index / BITS_PER_UNIT], count);
+}
+
+inline UInt32 BasicSuccinctBitVector::select_0_in_block(
+	UInt32 global_id, UInt32 count) const
+{
+	count -= global_id * BITS_PER_BLOCK - blocks_[global_id].global_rank();
+
+	UInt32 local_id = 1;
+	for ( ; local_id < UNITS_PER_BLOCK; ++local_id)
+	{
+		UInt32 local_rank = local_id * BITS_PER_UNIT
+			- blocks_[global_id].local_rank(local_id);
+		if (local_rank >= count)
+			break;
+	}
+	--local_id;
+	count -= local_id * BITS_PER_UNIT
+		- blocks_[global_id].local_rank(local_id);
+
+	UInt32 index = (global_id * BITS_PER_BLOCK) + (local_id * BITS_PER_UNIT);
+	return index + WordSelect::select_0(units_[index / BITS_PER_UNIT], count);
+}
+
 inline UInt32 BasicSuccinctBitVector::pop_count(UInt32 unit)
 {
 	unit = ((unit & 0xAAAAAAAA) >> 1) + (unit & 0x55555555);
@@ -108,7 +108,58 @@ inline bool BasicTrieBuilder::build_in_total_value_order(const TrieBase &trie,
 	return true;
 }
 
-inline void BasicTrieBuilder::build(UInt32 src_index, UInt32 dest_index)
+// Nodes visited by queries are arranged first in depth-first order, and
+// siblings and their subtrees are arranged in descending order of visits.
+// The other nodes follow in the same order as build().
+inline bool BasicTrieBuilder::build_in_query_order(const TrieBase &trie,
+	const char * const *queries, UInt32 num_queries,
+	ObjectArray<BasicTrieUnit> *units, ObjectArray<UInt8> *labels)
+{
+	assert(queries != NULL || num_queries == 0);
+	assert(units != NULL);
+	assert(labels != NULL);
+
+	if (!init(trie))
+		return false;
+
+	if (trie_->num_nodes() > 1)
+	{
+		std::vector<UInt32> counts;
+		count_visits(queries, num_queries, &counts);
+
+		std::vector<std::pair<UInt32, UInt32> > cold_nodes;
+		build_in_query_order(trie_->root(), 0, counts, &cold_nodes);
+
+		for (std::size_t i = 0; i < cold_nodes.size(); ++i)
+			build(cold_nodes[i].first, cold_nodes[i].second);
+	}
+
+	finish(units, labels);
+
+	return true;
+}
+
+inline bool BasicTrieBuilder::build_in_veb_order(const TrieBase &trie,
+	ObjectArray<BasicTrieUnit> *units, ObjectArray<UInt8> *labels)
+{
+	assert(units != NULL);
+	assert(labels != NULL);
+
+	if (!init(trie))
+		return false;
+
+	if (trie_->num_nodes() > 1)
+		build_in_veb_order(trie_->root(), 0, count_levels(trie_->root()));
+
+	finish(units, labels);
+
+	return true;
+}
+
+// Arranges the leaf and the children of a node, and returns the index of
+// the first child.
+inline UInt32 BasicTrieBuilder::arrange_children(UInt32 src_index,
+	UInt32 dest_index)
 {
 	assert(src_index < trie_->num_units());
 	assert(dest_index < num_units_);
@@ -139,7 +190,17 @@ inline void BasicTrieBuilder::build(UInt32 src_index, UInt32 dest_index)
 		src_child_index = trie_->sibling(src_child_index);
 	}
 
-	src_child_index = trie_->child(src_index);
+	return dest_child_index;
+}
+
+inline void BasicTrieBuilder::build(UInt32 src_index, UInt32 dest_index)
+{
+	assert(src_index < trie_->num_units());
+	assert(dest_index < num_units_);
+
+	UInt32 dest_child_index = arrange_children(src_index, dest_index);
+
+	UInt32 src_child_index = trie_->child(src_index);
 	while (src_child_index != 0)
 	{
 		build(src_child_index, dest_child_index);
@@ -261,6 +322,158 @@ inline void BasicTrieBuilder::build_in_value_order(UInt32 src_index,
 		dest_child_index, trie_->label(src_index), value));
 }
 
+// Counts the queries that pass through each node. A query that is not a
+// key still counts the nodes of its longest prefix in the trie.
+inline void BasicTrieBuilder::count_visits(const char * const *queries,
+	UInt32 num_queries, std::vector<UInt32> *counts) const
+{
+	assert(queries != NULL || num_queries == 0);
+	assert(counts != NULL);
+
+	counts->assign(trie_->num_units(), 0);
+	for (UInt32 query_id = 0; query_id < num_queries; ++query_id)
+	{
+		assert(queries[query_id] != NULL);
+
+		UInt32 index = trie_->root();
+		++(*counts)[index];
+		for (const char *query = queries[query_id]; *query != '\0'; ++query)
+		{
+			index = trie_->find_child(index, *query);
+			if (index == 0)
+				break;
+			++(*counts)[index];
+		}
+	}
+}
+
+inline void BasicTrieBuilder::build_in_query_order(UInt32 src_index,
+	UInt32 dest_index, const std::vector<UInt32> &counts,
+	std::vector<std::pair<UInt32, UInt32> > *cold_nodes)
+{
+	assert(src_index < trie_->num_units());
+	assert(dest_index < num_units_);
+	assert(cold_nodes != NULL);
+
+	units_[dest_index].set_child(num_units_);
+
+	UInt32 value;
+	bool has_value = trie_->get_value(src_index, &value);
+	bool has_sibling = false;
+	if (has_value)
+	{
+		UInt32 leaf_index = num_units_++;
+		labels_[leaf_index] = '\0';
+		units_[leaf_index].set_value(value);
+		has_sibling = true;
+	}
+
+	// A tuple keeps the source index of a child and its visits.
+	std::vector<BasicTrieBuilderTuple> tuples;
+	for (UInt32 src_child_index = trie_->child(src_index);
+		src_child_index != 0;
+		src_child_index = trie_->sibling(src_child_index))
+	{
+		tuples.push_back(BasicTrieBuilderTuple(src_child_index,
+			trie_->label(src_child_index), counts[src_child_index]));
+	}
+	std::stable_sort(tuples.begin(), tuples.end(), has_more_visits);
+
+	UInt32 dest_child_index = num_units_;
+	for (std::size_t i = 0; i < tuples.size(); ++i)
+	{
+		if (has_sibling)
+			units_[num_units_ - 1].set_has_sibling();
+		has_sibling = true;
+
+		labels_[num_units_++] = tuples[i].label();
+	}
+
+	for (std::size_t i = 0; i < tuples.size(); ++i, ++dest_child_index)
+	{
+		if (tuples[i].value() != 0)
+		{
+			build_in_query_order(tuples[i].child(), dest_child_index,
+				counts, cold_nodes);
+		}
+		else
+		{
+			cold_nodes->push_back(
+				std::make_pair(tuples[i].child(), dest_child_index));
+		}
+	}
+}
+
+// The runs of children in the top half of levels are arranged first, and
+// then each subtree below them is arranged in the same way. A path then
+// touches O(log_B n) blocks for any block size B.
+inline void BasicTrieBuilder::build_in_veb_order(UInt32 src_index,
+	UInt32 dest_index, UInt32 num_levels)
+{
+	assert(src_index < trie_->num_units());
+	assert(dest_index < num_units_);
+	assert(num_levels > 0);
+
+	if (num_levels == 1)
+	{
+		arrange_children(src_index, dest_index);
+		return;
+	}
+
+	UInt32 num_top_levels = num_levels / 2;
+	build_in_veb_order(src_index, dest_index, num_top_levels);
+
+	std::vector<std::pair<UInt32, UInt32> > nodes;
+	find_descendants(src_index, dest_index, num_top_levels, &nodes);
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+	{
+		build_in_veb_order(nodes[i].first, nodes[i].second,
+			num_levels - num_top_levels);
+	}
+}
+
+// Finds the pairs of source and destination indices of the descendants at
+// a depth. The children of the nodes above the depth must be arranged.
+inline void BasicTrieBuilder::find_descendants(UInt32 src_index,
+	UInt32 dest_index, UInt32 depth,
+	std::vector<std::pair<UInt32, UInt32> > *nodes) const
+{
+	assert(src_index < trie_->num_units());
+	assert(dest_index < num_units_);
+	assert(nodes != NULL);
+
+	if (depth == 0)
+	{
+		nodes->push_back(std::make_pair(src_index, dest_index));
+		return;
+	}
+
+	UInt32 dest_child_index = units_[dest_index].child();
+	if (trie_->has_value(src_index))
+		++dest_child_index;
+
+	for (UInt32 src_child_index = trie_->child(src_index);
+		src_child_index != 0;
+		src_child_index = trie_->sibling(src_child_index))
+	{
+		find_descendants(src_child_index, dest_child_index++, depth - 1,
+			nodes);
+	}
+}
+
+// Returns the number of nodes on the longest path from a node to a leaf.
+inline UInt32 BasicTrieBuilder::count_levels(UInt32 src_index) const
+{
+	assert(src_index < trie_->num_units());
+
+	UInt32 num_levels = 0;
+	for (UInt32 src_child_index = trie_->child(src_index);
+		src_child_index != 0;
+		src_child_index = trie_->sibling(src_child_index))
+		num_levels = std::max(num_levels, count_levels(src_child_index));
+	return num_levels + 1;
+}
+
 inline bool BasicTrieBuilder::init(const TrieBase &trie)
 {
 	if (trie.num_nodes() == 0)
@@ -321,6 +534,12 @@ inline UInt64 BasicTrieBuilder::get_total_value(
 	return total_value;
 }
 
+inline bool BasicTrieBuilder::has_more_visits(
+	const BasicTrieBuilderTuple &lhs, const BasicTrieBuilderTuple &rhs)
+{
+	return lhs.value() > rhs.value();
+}
+
 }  // namespace sumire
 
 #endif  // SUMIRE_BASIC_TRIE_BUILDER_IN_H
@@ -5,6 +5,7 @@
 #include "basic-trie-unit.h"
 #include "object-array.h"
 
+#include <utility>
 #include <vector>
 
 namespace sumire {
@@ -24,6 +25,11 @@ public:
 		ObjectArray<BasicTrieUnit> *units, ObjectArray<UInt8> *labels);
 	bool build_in_total_value_order(const TrieBase &trie,
 		ObjectArray<BasicTrieUnit> *units, ObjectArray<UInt8> *labels);
+	bool build_in_query_order(const TrieBase &trie,
+		const char * const *queries, UInt32 num_queries,
+		ObjectArray<BasicTrieUnit> *units, ObjectArray<UInt8> *labels);
+	bool build_in_veb_order(const TrieBase &trie,
+		ObjectArray<BasicTrieUnit> *units, ObjectArray<UInt8> *labels);
 
 private:
 	const TrieBase *trie_;
@@ -37,6 +43,13 @@ private:
 
 	void build(UInt32 src_index, UInt32 dest_index);
 	void build_in_level_order();
+	void build_in_veb_order(UInt32 src_index, UInt32 dest_index,
+		UInt32 num_levels);
+
+	UInt32 arrange_children(UInt32 src_index, UInt32 dest_index);
+	void find_descendants(UInt32 src_index, UInt32 dest_index,
+		UInt32 depth, std::vector<std::pair<UInt32, UInt32> > *nodes) const;
+	UInt32 count_levels(UInt32 src_index) const;
 
 	template <typename GET_LEAF_VALUE_FUNC,
 		typename GET_NON_LEAF_VALUE_FUNC>
@@ -45,6 +58,12 @@ private:
 		GET_LEAF_VALUE_FUNC get_leaf_value,
 		GET_NON_LEAF_VALUE_FUNC get_non_leaf_value);
 
+	void count_visits(const char * const *queries, UInt32 num_queries,
+		std::vector<UInt32> *counts) const;
+	void build_in_query_order(UInt32 src_index, UInt32 dest_index,
+		const std::vector<UInt32> &counts,
+		std::vector<std::pair<UInt32, UInt32> > *cold_nodes);
+
 	bool init(const TrieBase &trie);
 	void finish(ObjectArray<BasicTrieUnit> *units, ObjectArray<UInt8> *labels);
 
@@ -60,6 +79,9 @@ private:
 	static UInt64 get_total_value(
 		std::vector<BasicTrieBuilderTuple>::const_iterator begin,
 		std::vector<BasicTrieBuilderTuple>::const_iterator end);
+
+	static bool has_more_visits(const BasicTrieBuilderTuple &lhs,
+		const BasicTrieBuilderTuple &rhs);
 };
 
 }  // namespace sumire
@@ -2,6 +2,7 @@
 #define SUMIRE_BASIC_TRIE_IN_H
 
 #include "basic-trie-builder.h"
+#include "label-scanner.h"
 #include "object-io.h"
 
 #include <cassert>
@@ -33,6 +34,10 @@ inline bool BasicTrie::build(const TrieBase &trie, Order order)
 		if (!builder.build_in_total_value_order(trie, &units, &labels))
 			return false;
 		break;
+	case VEB_ORDER:
+		if (!builder.build_in_veb_order(trie, &units, &labels))
+			return false;
+		break;
 	}
 
 	clear();
@@ -43,6 +48,26 @@ inline bool BasicTrie::build(const TrieBase &trie, Order order)
 	return true;
 }
 
+inline bool BasicTrie::build(const TrieBase &trie,
+	const char * const *queries, UInt32 num_queries)
+{
+	ObjectArray<BasicTrieUnit> units;
+	ObjectArray<UInt8> labels;
+	UInt32 num_keys = trie.num_keys();
+
+	BasicTrieBuilder builder;
+	if (!builder.build_in_query_order(trie, queries, num_queries,
+		&units, &labels))
+		return false;
+
+	clear();
+	units_.swap(&units);
+	labels_.swap(&labels);
+	num_keys_ = num_keys;
+
+	return true;
+}
+
 inline bool BasicTrie::build(const TrieBase &trie)
 {
 	ObjectArray<BasicTrieUnit> units;
@@ -63,13 +88,14 @@ inline bool BasicTrie::build(const TrieBase &trie)
 
 inline UInt32 BasicTrie::find_child(UInt32 index, UInt8 child_label) const
 {
-	for (UInt32 child_index = child(index); child_index != 0;
-		child_index = sibling(child_index))
-	{
-		if (label(child_index) == child_label)
-			return child_index;
-	}
-	return 0;
+	UInt32 child_index = child(index);
+	if (child_index == 0)
+		return 0;
+
+	// The last unit has no sibling, so every run ends inside the arrays.
+	child_index += LabelScanner::scan(&labels_[child_index],
+		&units_[child_index], num_units() - child_index, child_label);
+	return (labels_[child_index] == child_label) ? child_index : 0;
 }
 
 inline UInt32 BasicTrie::child(UInt32 index) const
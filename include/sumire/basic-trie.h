@@ -17,11 +17,18 @@ public:
 		LEVEL_ORDER,
 		BREADTH_ORDER,
 		MAX_VALUE_ORDER,
-		TOTAL_VALUE_ORDER
+		TOTAL_VALUE_ORDER,
+		VEB_ORDER
 	};
 
 	bool build(const TrieBase &trie, Order order);
 
+	// Arranges the nodes visited by sample queries first, and siblings in
+	// descending order of visits, so that frequent lookups scan fewer
+	// siblings and touch fewer cache lines.
+	bool build(const TrieBase &trie, const char * const *queries,
+		UInt32 num_queries);
+
 public:
 	BasicTrie() : units_(), labels_(), num_keys_(0) {}
 	~BasicTrie() { clear(); }
@@ -3,6 +3,7 @@
 
 #include "object-io.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace sumire {
@@ -19,7 +20,7 @@ inline bool BitVector::get(UInt32 index) const
 
 	const UInt32 unit_id = index / BITS_PER_UNIT;
 	const UInt32 bit_id = index % BITS_PER_UNIT;
-	return (unit_pool_[unit_id] & (UNIT_1 << bit_id)) != 0;
+	return (unit_ref(unit_id) & (UNIT_1 << bit_id)) != 0;
 }
 
 inline void BitVector::set(UInt32 index, bool bit)
@@ -29,30 +30,158 @@ inline void BitVector::set(UInt32 index, bool bit)
 	const UInt32 unit_id = index / BITS_PER_UNIT;
 	const UInt32 bit_id = index % BITS_PER_UNIT;
 	if (bit)
-		unit_pool_[unit_id] |= (UNIT_1 << bit_id);
+		unit_ref(unit_id) |= (UNIT_1 << bit_id);
 	else
-		unit_pool_[unit_id] &= ~(UNIT_1 << bit_id);
+		unit_ref(unit_id) &= ~(UNIT_1 << bit_id);
 }
 
 inline void BitVector::add(bool bit)
 {
 	if (num_bits_ == capacity())
-		unit_pool_.alloc();
+		alloc_units(num_units() + 1);
 	++num_bits_;
 
 	set(num_bits_ - 1, bit);
 }
 
+inline void BitVector::append_bits(UInt64 bits, UInt32 num_bits)
+{
+	assert(num_bits <= 64);
+
+	if (num_bits == 0)
+		return;
+	else if (num_bits < 64)
+		bits &= (static_cast<UInt64>(1) << num_bits) - 1;
+
+	UInt32 unit_id = num_bits_ / BITS_PER_UNIT;
+	UInt32 bit_id = num_bits_ % BITS_PER_UNIT;
+
+	alloc_units((num_bits_ + num_bits + BITS_PER_UNIT - 1) / BITS_PER_UNIT);
+	num_bits_ += num_bits;
+
+	// The upper bits of a partially filled unit may be garbage, so they are
+	// cleared before merged with the new bits.
+	if (bit_id != 0)
+	{
+		UInt32 &unit = unit_ref(unit_id++);
+		unit = (unit & ((UNIT_1 << bit_id) - 1))
+			| static_cast<UInt32>(bits << bit_id);
+
+		UInt32 num_rest_bits = BITS_PER_UNIT - bit_id;
+		if (num_bits <= num_rest_bits)
+			return;
+		bits >>= num_rest_bits;
+		num_bits -= num_rest_bits;
+	}
+
+	for ( ; ; ++unit_id)
+	{
+		unit_ref(unit_id) = static_cast<UInt32>(bits);
+		if (num_bits <= BITS_PER_UNIT)
+			break;
+		bits >>= BITS_PER_UNIT;
+		num_bits -= BITS_PER_UNIT;
+	}
+}
+
+inline void BitVector::append_run(bool bit, UInt32 num_bits)
+{
+	const UInt32 fill = bit ? ~UNIT_0 : UNIT_0;
+
+	// Fills the partially filled unit, whole units and then the rest.
+	UInt32 num_head_bits = (BITS_PER_UNIT - (num_bits_ % BITS_PER_UNIT))
+		% BITS_PER_UNIT;
+	if (num_head_bits > num_bits)
+		num_head_bits = num_bits;
+	append_bits(fill, num_head_bits);
+	num_bits -= num_head_bits;
+
+	UInt32 num_body_units = num_bits / BITS_PER_UNIT;
+	if (num_body_units > 0)
+	{
+		UInt32 begin = num_bits_ / BITS_PER_UNIT;
+		UInt32 end = begin + num_body_units;
+		alloc_units(end);
+		if (is_contiguous())
+			std::fill(unit_array_.begin() + begin,
+				unit_array_.begin() + end, fill);
+		else
+		{
+			for (UInt32 unit_id = begin; unit_id < end; ++unit_id)
+				unit_pool_[unit_id] = fill;
+		}
+		num_bits_ += num_body_units * BITS_PER_UNIT;
+	}
+
+	append_bits(fill, num_bits % BITS_PER_UNIT);
+}
+
+inline void BitVector::append_unary(UInt32 value)
+{
+	if (value < 64)
+		append_bits((static_cast<UInt64>(1) << value) - 1, value + 1);
+	else
+	{
+		append_run(true, value);
+		add(false);
+	}
+}
+
 inline UInt32 BitVector::unit(UInt32 unit_id) const
 {
 	assert(unit_id < num_units());
 
-	return unit_pool_[unit_id];
+	return unit_ref(unit_id);
+}
+
+inline const UInt32 *BitVector::units() const
+{
+	assert(is_contiguous());
+
+	return unit_array_.begin();
+}
+
+// This function moves the units into *units, and then clears the bit
+// vector. The number of moved units is equal to num_units().
+inline void BitVector::release(ObjectArray<UInt32> *units)
+{
+	assert(units != NULL);
+	assert(is_contiguous());
+
+	if (unit_array_.num_objs() != num_units_)
+		realloc_unit_array(num_units_);
+
+	units->swap(&unit_array_);
+	clear();
+}
+
+inline void BitVector::reserve(UInt32 num_bits)
+{
+	if (!is_contiguous())
+		return;
+
+	UInt32 num_units = (num_bits + BITS_PER_UNIT - 1) / BITS_PER_UNIT;
+	if (num_units > unit_array_.num_objs())
+		realloc_unit_array(num_units);
+}
+
+inline void BitVector::resize(UInt32 num_bits, bool initial_bit)
+{
+	if (num_bits > num_bits_)
+		append_run(initial_bit, num_bits - num_bits_);
+	else
+	{
+		num_bits_ = num_bits;
+		if (is_contiguous())
+			num_units_ = (num_bits + BITS_PER_UNIT - 1) / BITS_PER_UNIT;
+	}
 }
 
 inline void BitVector::clear()
 {
 	unit_pool_.clear();
+	unit_array_.clear();
+	num_units_ = 0;
 	num_bits_ = 0;
 }
 
@@ -60,7 +189,14 @@ inline void *BitVector::map(void *addr)
 {
 	assert(addr != NULL);
 
-	addr = unit_pool_.map(addr);
+	clear();
+	if (is_contiguous())
+	{
+		addr = unit_array_.map(addr);
+		num_units_ = unit_array_.num_objs();
+	}
+	else
+		addr = unit_pool_.map(addr);
 
 	ObjectClipper clipper(addr);
 	num_bits_ = *clipper.clip<UInt32>();
@@ -73,7 +209,8 @@ inline bool BitVector::read(std::istream *input)
 	assert(input != NULL);
 
 	ObjectPool<UInt32> unit_pool;
-	if (!unit_pool.read(input))
+	ObjectArray<UInt32> unit_array;
+	if (is_contiguous() ? !unit_array.read(input) : !unit_pool.read(input))
 		return false;
 
 	ObjectReader reader(input);
@@ -84,6 +221,8 @@ inline bool BitVector::read(std::istream *input)
 
 	clear();
 	unit_pool_.swap(&unit_pool);
+	unit_array_.swap(&unit_array);
+	num_units_ = unit_array_.num_objs();
 	num_bits_ = num_bits;
 
 	return true;
@@ -93,11 +232,19 @@ inline bool BitVector::write(std::ostream *output) const
 {
 	assert(output != NULL);
 
-	if (!unit_pool_.write(output))
-		return false;
-
 	ObjectWriter writer(output);
 
+	// Both modes share the same format.
+	if (is_contiguous())
+	{
+		if (!writer.write(num_units_))
+			return false;
+		if (!writer.write(unit_array_.begin(), num_units_))
+			return false;
+	}
+	else if (!unit_pool_.write(output))
+		return false;
+
 	if (!writer.write(num_bits_))
 		return false;
 
@@ -109,7 +256,54 @@ inline void BitVector::swap(BitVector *target)
 	assert(target != NULL);
 
 	unit_pool_.swap(&target->unit_pool_);
+	unit_array_.swap(&target->unit_array_);
+	std::swap(num_units_, target->num_units_);
 	std::swap(num_bits_, target->num_bits_);
+	std::swap(storage_mode_, target->storage_mode_);
+}
+
+inline const UInt32 &BitVector::unit_ref(UInt32 unit_id) const
+{
+	assert(unit_id < num_units());
+
+	return is_contiguous() ? unit_array_[unit_id] : unit_pool_[unit_id];
+}
+
+inline UInt32 &BitVector::unit_ref(UInt32 unit_id)
+{
+	assert(unit_id < num_units());
+
+	return is_contiguous() ? unit_array_[unit_id] : unit_pool_[unit_id];
+}
+
+inline void BitVector::alloc_units(UInt32 num_units)
+{
+	if (!is_contiguous())
+	{
+		while (unit_pool_.num_objs() < num_units)
+			unit_pool_.alloc();
+		return;
+	}
+
+	if (num_units > unit_array_.num_objs())
+	{
+		UInt32 num_objs = unit_array_.num_objs() * 2;
+		realloc_unit_array((num_objs > num_units) ? num_objs : num_units);
+	}
+	if (num_units > num_units_)
+		num_units_ = num_units;
+}
+
+inline void BitVector::realloc_unit_array(UInt32 num_units)
+{
+	assert(num_units >= num_units_);
+
+	ObjectArray<UInt32> unit_array;
+	unit_array.resize(num_units);
+	std::copy(unit_array_.begin(), unit_array_.begin() + num_units_,
+		unit_array.begin());
+
+	unit_array_.swap(&unit_array);
 }
 
 }  // namespace sumire
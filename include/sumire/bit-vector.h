@@ -15,6 +15,15 @@ public:
 	static const UInt32 UNIT_0 = 0;
 	static const UInt32 UNIT_1 = 1;
 
+	// A pooled bit vector allocates units block by block, whereas a
+	// contiguous bit vector keeps its units in one array, which can be
+	// accessed through units() and handed over by release().
+	enum StorageMode
+	{
+		POOLED_STORAGE,
+		CONTIGUOUS_STORAGE
+	};
+
 	class Accessor
 	{
 	public:
@@ -31,7 +40,9 @@ public:
 	};
 
 public:
-	BitVector() : unit_pool_(), num_bits_(0) {}
+	explicit BitVector(StorageMode storage_mode = POOLED_STORAGE)
+		: unit_pool_(), unit_array_(), num_units_(0), num_bits_(0),
+		storage_mode_(storage_mode) {}
 	~BitVector() { clear(); }
 
 	bool operator[](UInt32 index) const { return get(index); }
@@ -41,13 +52,32 @@ public:
 	void set(UInt32 index, bool bit);
 	void add(bool bit);
 
+	// Appends the lower num_bits bits of bits from the LSB (num_bits <= 64).
+	void append_bits(UInt64 bits, UInt32 num_bits);
+	// Appends num_bits copies of bit.
+	void append_run(bool bit, UInt32 num_bits);
+	// Appends value 1s followed by a 0.
+	void append_unary(UInt32 value);
+
 	UInt32 unit(UInt32 unit_id) const;
 
-	UInt32 num_units() const { return unit_pool_.num_objs(); }
+	// These functions are available only in contiguous mode.
+	const UInt32 *units() const;
+	void release(ObjectArray<UInt32> *units);
+
+	StorageMode storage_mode() const { return storage_mode_; }
+	bool is_contiguous() const
+	{ return storage_mode_ == CONTIGUOUS_STORAGE; }
+
+	UInt32 num_units() const
+	{ return is_contiguous() ? num_units_ : unit_pool_.num_objs(); }
 	UInt32 num_bits() const { return num_bits_; }
-	UInt32 size() const { return unit_pool_.size(); }
+	UInt32 size() const
+	{ return is_contiguous() ? unit_array_.size() : unit_pool_.size(); }
 	UInt32 capacity() const { return num_units() * BITS_PER_UNIT; }
 
+	// In pooled mode, reserve() does nothing.
+	void reserve(UInt32 num_bits);
 	void resize(UInt32 num_bits, bool initial_bit = false);
 
 	void clear();
@@ -59,11 +89,20 @@ public:
 
 private:
 	ObjectPool<UInt32> unit_pool_;
+	ObjectArray<UInt32> unit_array_;
+	UInt32 num_units_;
 	UInt32 num_bits_;
+	StorageMode storage_mode_;
 
 	// Disallows copies.
 	BitVector(const BitVector &);
 	BitVector &operator=(const BitVector &);
+
+	const UInt32 &unit_ref(UInt32 unit_id) const;
+	UInt32 &unit_ref(UInt32 unit_id);
+
+	void alloc_units(UInt32 num_units);
+	void realloc_unit_array(UInt32 num_units);
 };
 
 }  // namespace sumire
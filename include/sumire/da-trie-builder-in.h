@@ -8,13 +8,14 @@
 namespace sumire {
 
 inline bool DaTrieBuilder::build(const TrieBase &trie,
-	ObjectArray<DaTrieUnit> *units_ptr)
+	ObjectArray<DaTrieUnit> *units_ptr, bool inlines_leaves)
 {
 	if (trie.num_nodes() == 0)
 		return false;
 
 	clear();
 	trie_ = &trie;
+	inlines_leaves_ = inlines_leaves;
 
 	reserve(0);
 
@@ -45,6 +46,22 @@ inline void DaTrieBuilder::build_da(UInt32 trie_index, UInt32 da_index)
 //	if (trie_->label(trie_index) == '\0')
 //		return;
 
+	// A node without children and values, such as a link node of
+	// HybridTrie, has nothing to arrange.
+	UInt32 value;
+	if (trie_->child(trie_index) == 0)
+	{
+		if (!trie_->get_value(trie_index, &value))
+			return;
+		if (inlines_leaves_)
+		{
+			assert(value < (static_cast<UInt32>(1) << 31));
+			unit(da_index).set_inline_value(value);
+			unit(da_index).set_has_leaf();
+			return;
+		}
+	}
+
 	UInt32 offset = arrange_nodes(trie_index, da_index);
 
 	UInt32 trie_child_index = trie_->child(trie_index);
@@ -283,6 +300,7 @@ inline void DaTrieBuilder::clear()
 		delete[] temp_blocks_[block_id];
 
 	trie_ = NULL;
+	inlines_leaves_ = false;
 	unit_pool_.clear();
 	std::vector<DaTrieTempUnit *>(0).swap(temp_blocks_);
 	std::vector<UInt8>(0).swap(labels_);
@@ -13,14 +13,18 @@ namespace sumire {
 class DaTrieBuilder
 {
 public:
-	DaTrieBuilder() : trie_(NULL), unit_pool_(), temp_blocks_(),
-		labels_(), unfixed_index_(0) {}
+	DaTrieBuilder() : trie_(NULL), inlines_leaves_(false),
+		unit_pool_(), temp_blocks_(), labels_(), unfixed_index_(0) {}
 	~DaTrieBuilder() { clear(); }
 
-	bool build(const TrieBase &trie, ObjectArray<DaTrieUnit> *units_ptr);
+	// If inlines_leaves is true, a node that has a value and no children
+	// keeps the value in its own unit instead of a leaf unit.
+	bool build(const TrieBase &trie, ObjectArray<DaTrieUnit> *units_ptr,
+		bool inlines_leaves = false);
 
 private:
 	const TrieBase *trie_;
+	bool inlines_leaves_;
 	ObjectPool<DaTrieUnit> unit_pool_;
 	std::vector<DaTrieTempUnit *> temp_blocks_;
 	std::vector<UInt8> labels_;
@@ -8,14 +8,14 @@
 
 namespace sumire {
 
-inline bool DaTrie::build(const TrieBase &trie)
+inline bool DaTrie::build(const TrieBase &trie, Layout layout)
 {
 	ObjectArray<DaTrieUnit> units;
 	UInt32 num_nodes = trie.num_nodes();
 	UInt32 num_keys = trie.num_keys();
 
 	DaTrieBuilder builder;
-	if (!builder.build(trie, &units))
+	if (!builder.build(trie, &units, layout == INLINE_LEAF_LAYOUT))
 		return false;
 
 	clear();
@@ -26,6 +26,11 @@ inline bool DaTrie::build(const TrieBase &trie)
 	return true;
 }
 
+inline bool DaTrie::build(const TrieBase &trie)
+{
+	return build(trie, LEAF_UNIT_LAYOUT);
+}
+
 inline UInt32 DaTrie::find_child(UInt32 index, UInt8 child_label) const
 {
 	assert(index < num_units());
@@ -33,7 +38,10 @@ inline UInt32 DaTrie::find_child(UInt32 index, UInt8 child_label) const
 	if (child_label == '\0')
 		return 0;
 
-	index = units_[index].offset() ^ child_label;
+	// The offset of an inline leaf has the top bit set, and then the mask
+	// moves the index to the root, whose label is '\0'.
+	UInt32 offset = units_[index].offset();
+	index = (offset ^ child_label) & ((offset >> 31) - 1);
 	if (units_[index].label() == child_label)
 		return index;
 	return 0;
@@ -75,7 +83,8 @@ inline bool DaTrie::get_value(UInt32 index, UInt32 *value_ptr) const
 
 	if (value_ptr != NULL)
 	{
-		UInt32 leaf_index = units_[index].offset();
+		UInt32 leaf_index = units_[index].is_leaf_inline() ?
+			index : units_[index].offset();
 		assert(leaf_index < num_units());
 
 		*value_ptr = units_[leaf_index].value();
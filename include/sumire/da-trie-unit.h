@@ -13,19 +13,27 @@ public:
 
 	void set_offset(UInt32 offset) { unit_ = offset; }
 	void set_value(UInt32 value) { unit_ = value; }
+	void set_inline_value(UInt32 value)
+	{ unit_ = value | IS_LEAF_INLINE_FLAG; }
 	void set_label(UInt8 label) { label_ = label; }
 	void set_has_leaf() { has_leaf_ = true; }
 	void set_child_label(UInt8 label) { child_label_ = label; }
 	void set_next_sibling(UInt8 diff) { next_sibling_ = diff; }
 
 	UInt32 offset() const { return unit_; }
-	UInt32 value() const { return unit_; }
+	UInt32 value() const
+	{ return unit_ & ~static_cast<UInt32>(IS_LEAF_INLINE_FLAG); }
 	UInt32 label() const { return label_; }
 	bool has_leaf() const { return has_leaf_; }
+	bool is_leaf_inline() const { return (unit_ & IS_LEAF_INLINE_FLAG) != 0; }
 	UInt8 child_label() const { return child_label_; }
 	UInt8 next_sibling() const { return next_sibling_; }
 
 private:
+	// An inline leaf keeps its value in unit_ instead of an offset, and
+	// the top bit marks it. Values and offsets are less than 2^31.
+	enum { IS_LEAF_INLINE_FLAG = 1U << 31 };
+
 	UInt32 unit_;
 	UInt8 label_;
 	bool has_leaf_;
@@ -11,7 +11,18 @@ namespace sumire {
 class DaTrie : public TrieBase
 {
 public:
-	DaTrie() : units_() {}
+	// INLINE_LEAF_LAYOUT keeps the value of a node without children in its
+	// own unit, so that get_value() does not access another unit.
+	enum Layout
+	{
+		LEAF_UNIT_LAYOUT,
+		INLINE_LEAF_LAYOUT
+	};
+
+	bool build(const TrieBase &trie, Layout layout);
+
+public:
+	DaTrie() : units_(), num_nodes_(0), num_keys_(0) {}
 	~DaTrie() { clear(); }
 
 	bool build(const TrieBase &trie);
@@ -0,0 +1,76 @@
+#ifndef SUMIRE_FOR_EACH_KEY_IN_H
+#define SUMIRE_FOR_EACH_KEY_IN_H
+
+#include <cassert>
+
+namespace sumire {
+
+// indices[i] keeps the node that has key[i] as its label.
+template <typename TRIE_TYPE, typename VISITOR_TYPE, std::size_t KEY_SIZE>
+inline ForEachKey::Status for_each_key(const TRIE_TYPE &trie,
+	const char *prefix, VISITOR_TYPE *visitor, char (&key)[KEY_SIZE],
+	UInt32 (&indices)[KEY_SIZE])
+{
+	assert(prefix != NULL);
+	assert(visitor != NULL);
+
+	if (trie.TRIE_TYPE::num_units() == 0)
+		return ForEachKey::COMPLETED;
+
+	UInt32 index = trie.TRIE_TYPE::root();
+	UInt32 length = 0;
+	for ( ; prefix[length] != '\0'; ++length)
+	{
+		if (length + 1 >= KEY_SIZE)
+			return ForEachKey::KEY_TOO_LONG;
+
+		index = trie.TRIE_TYPE::find_child(index, prefix[length]);
+		if (index == 0)
+			return ForEachKey::COMPLETED;
+		key[length] = prefix[length];
+	}
+
+	const UInt32 prefix_length = length;
+	for ( ; ; )
+	{
+		UInt32 value;
+		if (trie.TRIE_TYPE::get_value(index, &value))
+		{
+			key[length] = '\0';
+			if (!(*visitor)(static_cast<const char *>(key), length, value))
+				return ForEachKey::STOPPED;
+		}
+
+		UInt32 child_index = trie.TRIE_TYPE::child(index);
+		if (child_index != 0)
+		{
+			if (length + 1 >= KEY_SIZE)
+				return ForEachKey::KEY_TOO_LONG;
+
+			indices[length] = child_index;
+			key[length++] = trie.TRIE_TYPE::label(child_index);
+			index = child_index;
+			continue;
+		}
+
+		for ( ; ; )
+		{
+			if (length == prefix_length)
+				return ForEachKey::COMPLETED;
+
+			UInt32 sibling_index = trie.TRIE_TYPE::sibling(indices[length - 1]);
+			if (sibling_index != 0)
+			{
+				indices[length - 1] = sibling_index;
+				key[length - 1] = trie.TRIE_TYPE::label(sibling_index);
+				index = sibling_index;
+				break;
+			}
+			--length;
+		}
+	}
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_FOR_EACH_KEY_IN_H
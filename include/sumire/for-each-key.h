@@ -0,0 +1,45 @@
+#ifndef SUMIRE_FOR_EACH_KEY_H
+#define SUMIRE_FOR_EACH_KEY_H
+
+#include "int-types.h"
+
+#include <cstddef>
+
+namespace sumire {
+
+class ForEachKey
+{
+public:
+	enum Status
+	{
+		COMPLETED,
+		STOPPED,
+		KEY_TOO_LONG
+	};
+
+private:
+	ForEachKey();
+};
+
+// for_each_key() passes the keys that start with a prefix to a visitor, in
+// the order of child() and sibling(). A visitor is called as
+// (*visitor)(key, length, value) and returns false to stop enumeration.
+//
+// The key is built in the caller's buffer, and the path is kept in the
+// caller's index buffer of the same capacity, so that enumeration neither
+// allocates memory nor puts a large array on the stack. TRIE_TYPE must be
+// the concrete type of the trie, because its members are called without
+// virtual dispatch.
+//
+// Returns STOPPED if the visitor stops enumeration, and KEY_TOO_LONG if a
+// key does not fit into the buffer.
+template <typename TRIE_TYPE, typename VISITOR_TYPE, std::size_t KEY_SIZE>
+ForEachKey::Status for_each_key(const TRIE_TYPE &trie, const char *prefix,
+	VISITOR_TYPE *visitor, char (&key)[KEY_SIZE],
+	UInt32 (&indices)[KEY_SIZE]);
+
+}  // namespace sumire
+
+#include "for-each-key-in.h"
+
+#endif  // SUMIRE_FOR_EACH_KEY_H
@@ -0,0 +1,329 @@
+#ifndef SUMIRE_FUZZY_SEARCHER_IN_H
+#define SUMIRE_FUZZY_SEARCHER_IN_H
+
+#include "top-k-completer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace sumire {
+
+inline bool FuzzySearcher::start(const TrieBase &trie, const char *query,
+	UInt32 max_distance)
+{
+	assert(query != NULL);
+
+	if (trie.num_units() == 0)
+		return false;
+
+	init(trie, query, max_distance);
+
+	return true;
+}
+
+// Nodes whose rows end within max_distance are the roots of completions,
+// and their descendants are left to TopKCompleter.
+inline bool FuzzySearcher::start_completion(const TrieBase &trie,
+	const char *query, UInt32 max_distance, UInt32 max_num_results,
+	const MaxValueTable *max_values)
+{
+	assert(query != NULL);
+
+	if (trie.num_units() == 0)
+		return false;
+
+	init(trie, query, max_distance);
+
+	bool descends;
+	do
+	{
+		descends = last_distance() > max_distance_;
+		if (!descends)
+			add_completions(max_values, max_num_results);
+	} while (find_next(descends));
+
+	sort_results(max_num_results);
+
+	return true;
+}
+
+inline bool FuzzySearcher::next()
+{
+	if (!indices_.empty())
+	{
+		if (is_started_ && !find_next(true))
+			return false;
+		is_started_ = true;
+
+		do
+		{
+			if (last_distance() <= max_distance_ &&
+				trie_->get_value(indices_.back(), &value_))
+			{
+				distance_ = last_distance();
+				return true;
+			}
+		} while (find_next(true));
+
+		return false;
+	}
+
+	if (result_id_ >= result_values_.size())
+		return false;
+
+	const char *key = &result_keys_[result_key_begins_[result_id_]];
+	key_.assign(key, key + std::strlen(key) + 1);
+	value_ = result_values_[result_id_];
+	distance_ = result_distances_[result_id_];
+	++result_id_;
+
+	return true;
+}
+
+inline const char *FuzzySearcher::key() const
+{
+	assert(key_.size() > 0);
+
+	return &key_[0];
+}
+
+inline void FuzzySearcher::clear()
+{
+	trie_ = NULL;
+	query_.clear();
+	max_distance_ = 0;
+	rows_.clear();
+	indices_.clear();
+	min_distances_.clear();
+	next_children_.clear();
+	next_positions_.clear();
+	key_.clear();
+	value_ = TrieBase::INVALID_VALUE;
+	distance_ = 0;
+	is_started_ = false;
+	result_keys_.clear();
+	result_key_begins_.clear();
+	result_values_.clear();
+	result_distances_.clear();
+	result_id_ = 0;
+}
+
+inline void FuzzySearcher::init(const TrieBase &trie, const char *query,
+	UInt32 max_distance)
+{
+	clear();
+
+	trie_ = &trie;
+	query_.assign(query, query + std::strlen(query));
+	max_distance_ = max_distance;
+
+	for (UInt32 i = 0; i < row_width(); ++i)
+		rows_.push_back(std::min(i, max_distance + 1));
+	indices_.push_back(trie.root());
+	min_distances_.push_back(0);
+	next_children_.push_back(0);
+	next_positions_.push_back(static_cast<UInt32>(query_.size()));
+	key_.push_back('\0');
+}
+
+// Moves to the next node in depth-first order that has a row within
+// max_distance. The start node is visited first, and its siblings are
+// never visited.
+inline bool FuzzySearcher::find_next(bool descends)
+{
+	assert(!indices_.empty());
+
+	if (descends)
+		init_children();
+	else
+		next_children_.back() = 0;
+
+	for ( ; ; )
+	{
+		for (UInt32 index = find_child(); index != 0; index = find_child())
+		{
+			if (push_node(index))
+				return true;
+		}
+
+		if (indices_.size() == 1)
+		{
+			indices_.clear();
+			return false;
+		}
+		pop_node();
+	}
+}
+
+// If a row has no entry less than max_distance, a child can stay within
+// max_distance only by matching the query where the row has max_distance.
+// Such children are found with find_child() instead of scanning all the
+// children.
+inline void FuzzySearcher::init_children()
+{
+	if (min_distances_.back() == max_distance_)
+	{
+		next_children_.back() = 0;
+		next_positions_.back() = 0;
+	}
+	else
+	{
+		next_children_.back() = trie_->child(indices_.back());
+		next_positions_.back() = static_cast<UInt32>(query_.size());
+	}
+}
+
+inline UInt32 FuzzySearcher::find_child()
+{
+	UInt32 index = next_children_.back();
+	if (index != 0)
+	{
+		next_children_.back() = trie_->sibling(index);
+		return index;
+	}
+
+	const UInt32 *row = &rows_[rows_.size() - row_width()];
+	UInt32 &position = next_positions_.back();
+	while (position < query_.size())
+	{
+		UInt32 i = position++;
+		if (row[i] != max_distance_)
+			continue;
+
+		bool is_new_label = true;
+		for (UInt32 j = 0; j < i; ++j)
+		{
+			if (row[j] == max_distance_ && query_[j] == query_[i])
+				is_new_label = false;
+		}
+		if (!is_new_label)
+			continue;
+
+		index = trie_->find_child(indices_.back(), query_[i]);
+		if (index != 0)
+			return index;
+	}
+	return 0;
+}
+
+// Only the entries within max_distance of the diagonal can be within
+// max_distance, and the others are kept as max_distance + 1.
+inline bool FuzzySearcher::push_node(UInt32 index)
+{
+	UInt8 label = trie_->label(index);
+
+	UInt32 width = row_width();
+	UInt32 begin = rows_.size();
+	rows_.resize(begin + width, max_distance_ + 1);
+
+	const UInt32 *prev_row = &rows_[begin - width];
+	UInt32 *row = &rows_[begin];
+
+	UInt32 depth = indices_.size();
+	UInt32 first = (depth > max_distance_) ? (depth - max_distance_) : 0;
+	UInt32 last = std::min(depth + max_distance_, width - 1);
+
+	UInt32 min_distance = max_distance_ + 1;
+	if (first == 0)
+	{
+		row[0] = std::min(prev_row[0] + 1, max_distance_ + 1);
+		min_distance = row[0];
+		first = 1;
+	}
+	for (UInt32 i = first; i <= last; ++i)
+	{
+		UInt32 distance = prev_row[i - 1] + (query_[i - 1] != label);
+		distance = std::min(distance, prev_row[i] + 1);
+		distance = std::min(distance, row[i - 1] + 1);
+		distance = std::min(distance, max_distance_ + 1);
+		row[i] = distance;
+		min_distance = std::min(min_distance, distance);
+	}
+
+	if (min_distance > max_distance_)
+	{
+		rows_.resize(begin);
+		return false;
+	}
+
+	indices_.push_back(index);
+	min_distances_.push_back(min_distance);
+	next_children_.push_back(0);
+	next_positions_.push_back(static_cast<UInt32>(query_.size()));
+	key_.back() = static_cast<char>(label);
+	key_.push_back('\0');
+
+	return true;
+}
+
+inline void FuzzySearcher::pop_node()
+{
+	assert(indices_.size() > 1);
+
+	indices_.pop_back();
+	min_distances_.pop_back();
+	next_children_.pop_back();
+	next_positions_.pop_back();
+	rows_.resize(rows_.size() - row_width());
+	key_.pop_back();
+	key_.back() = '\0';
+}
+
+inline void FuzzySearcher::add_completions(const MaxValueTable *max_values,
+	UInt32 max_num_results)
+{
+	TopKCompleter completer;
+	if (max_values != NULL)
+	{
+		completer.start(*trie_, *max_values, indices_.back(),
+			max_num_results);
+	}
+	else
+		completer.start(*trie_, indices_.back(), max_num_results);
+
+	while (completer.next())
+	{
+		result_key_begins_.push_back(result_keys_.size());
+		result_keys_.insert(result_keys_.end(), key_.begin(), key_.end() - 1);
+		result_keys_.insert(result_keys_.end(), completer.key(),
+			completer.key() + completer.length() + 1);
+		result_values_.push_back(completer.value());
+		result_distances_.push_back(last_distance());
+	}
+}
+
+// Results are sorted in descending order of values, and results with the
+// same value keep their order.
+inline void FuzzySearcher::sort_results(UInt32 max_num_results)
+{
+	std::vector<std::pair<UInt32, UInt32> > pairs;
+	for (UInt32 id = 0; id < result_values_.size(); ++id)
+		pairs.push_back(std::make_pair(~result_values_[id], id));
+	std::sort(pairs.begin(), pairs.end());
+	if (pairs.size() > max_num_results)
+		pairs.resize(max_num_results);
+
+	std::vector<char> keys;
+	std::vector<UInt32> key_begins, values, distances;
+	for (std::size_t i = 0; i < pairs.size(); ++i)
+	{
+		UInt32 id = pairs[i].second;
+		const char *key = &result_keys_[result_key_begins_[id]];
+		key_begins.push_back(keys.size());
+		keys.insert(keys.end(), key, key + std::strlen(key) + 1);
+		values.push_back(result_values_[id]);
+		distances.push_back(result_distances_[id]);
+	}
+
+	result_keys_.swap(keys);
+	result_key_begins_.swap(key_begins);
+	result_values_.swap(values);
+	result_distances_.swap(distances);
+	result_id_ = 0;
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_FUZZY_SEARCHER_IN_H
@@ -0,0 +1,91 @@
+#ifndef SUMIRE_FUZZY_SEARCHER_H
+#define SUMIRE_FUZZY_SEARCHER_H
+
+#include "max-value-table.h"
+#include "trie-base.h"
+
+#include <vector>
+
+namespace sumire {
+
+// FuzzySearcher finds keys within an edit distance of a query. It walks a
+// trie in depth-first order with a row of the Levenshtein table for each
+// depth, and skips a subtree as soon as every entry of its row exceeds
+// the maximum distance. Keys come in depth-first order, but siblings are
+// not always in the order of sibling().
+class FuzzySearcher
+{
+public:
+	FuzzySearcher() : trie_(NULL), query_(), max_distance_(0), rows_(),
+		indices_(), min_distances_(), next_children_(), next_positions_(),
+		key_(), value_(0), distance_(0), is_started_(false),
+		result_keys_(), result_key_begins_(), result_values_(),
+		result_distances_(), result_id_(0) {}
+	~FuzzySearcher() { clear(); }
+
+	// Finds the keys within max_distance of a query.
+	bool start(const TrieBase &trie, const char *query, UInt32 max_distance);
+	// Finds up to max_num_results keys that start with a string within
+	// max_distance of a query, in descending order of values. Siblings must
+	// be in MAX_VALUE_ORDER unless a MaxValueTable of the trie is given.
+	bool start_completion(const TrieBase &trie, const char *query,
+		UInt32 max_distance, UInt32 max_num_results,
+		const MaxValueTable *max_values = NULL);
+	bool next();
+
+	const char *key() const;
+	UInt32 length() const { return key_.size() - 1; }
+	UInt32 value() const { return value_; }
+	// In completion, the distance of the shortest prefix within
+	// max_distance is given.
+	UInt32 distance() const { return distance_; }
+
+	void clear();
+
+private:
+	const TrieBase *trie_;
+	std::vector<UInt8> query_;
+	UInt32 max_distance_;
+	// Rows of the Levenshtein table are stored one after another.
+	std::vector<UInt32> rows_;
+	// Nodes on the path, the minimum entries of their rows, and the states
+	// of finding their children.
+	std::vector<UInt32> indices_;
+	std::vector<UInt32> min_distances_;
+	std::vector<UInt32> next_children_;
+	std::vector<UInt32> next_positions_;
+	std::vector<char> key_;
+	UInt32 value_;
+	UInt32 distance_;
+	bool is_started_;
+	std::vector<char> result_keys_;
+	std::vector<UInt32> result_key_begins_;
+	std::vector<UInt32> result_values_;
+	std::vector<UInt32> result_distances_;
+	UInt32 result_id_;
+
+	// Disallows copies.
+	FuzzySearcher(const FuzzySearcher &);
+	FuzzySearcher &operator=(const FuzzySearcher &);
+
+	void init(const TrieBase &trie, const char *query, UInt32 max_distance);
+
+	bool find_next(bool descends);
+	void init_children();
+	UInt32 find_child();
+	bool push_node(UInt32 index);
+	void pop_node();
+
+	UInt32 row_width() const { return query_.size() + 1; }
+	UInt32 last_distance() const { return rows_.back(); }
+
+	void add_completions(const MaxValueTable *max_values,
+		UInt32 max_num_results);
+	void sort_results(UInt32 max_num_results);
+};
+
+}  // namespace sumire
+
+#include "fuzzy-searcher-in.h"
+
+#endif  // SUMIRE_FUZZY_SEARCHER_H
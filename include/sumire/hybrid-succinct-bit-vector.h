@@ -43,16 +43,36 @@ public:
 	~HybridSuccinctBitVector() { clear(); }
 
 	void build(const BitVector &bv);
+	void build(BitVector *bv);
+	void build(const UInt32 *units, UInt32 num_bits);
+	void build(ObjectArray<UInt32> *units, UInt32 num_bits);
 
 	UInt32 rank_1(UInt32 index) const;
 	UInt32 rank_0(UInt32 index) const;
 
+	// These functions answer rank queries for sorted indices in one pass.
+	void rank_1(const UInt32 *indices, UInt32 num_indices,
+		UInt32 *ranks) const;
+	void rank_0(const UInt32 *indices, UInt32 num_indices,
+		UInt32 *ranks) const;
+
 	UInt32 select_1(UInt32 count) const;
 	UInt32 select_0(UInt32 count) const;
 
+	// These functions answer select queries for sorted counts in one pass.
+	void select_1(const UInt32 *counts, UInt32 num_counts,
+		UInt32 *indices) const;
+	void select_0(const UInt32 *counts, UInt32 num_counts,
+		UInt32 *indices) const;
+
 	bool operator[](UInt32 index) const;
 	bool get(UInt32 index) const;
 
+	// Returns the unit that holds bits [unit_id * 32, (unit_id + 1) * 32).
+	UInt32 unit(UInt32 unit_id) const;
+	// Returns the length of the run of 1s that starts at index.
+	UInt32 run_length_1(UInt32 index) const;
+
 	UInt32 num_blocks() const { return rank_blocks_.num_objs(); }
 	UInt32 num_units() const { return units_.num_objs(); }
 	UInt32 num_bits() const { return num_bits_; }
@@ -68,6 +88,9 @@ public:
 	void swap(HybridSuccinctBitVector *target);
 
 private:
+	enum { MIN_PARALLEL_NUM_BLOCKS = 1 << 12 };
+	enum { PREFETCH_DISTANCE = 8 };
+
 	ObjectArray<RankBlock> rank_blocks_;
 	ObjectArray<UInt32> select_1s_;
 	ObjectArray<UInt32> select_0s_;
@@ -82,6 +105,16 @@ private:
 	void build_select(const ObjectArray<RankBlock> &rank_blocks,
 		UInt32 num_ones, UInt32 num_zeros,
 		ObjectArray<UInt32> *select_1s, ObjectArray<UInt32> *select_0s);
+	static UInt32 num_thresholds(UInt32 rank);
+
+	static void count_block(const ObjectArray<UInt32> &units,
+		UInt32 num_bits, UInt32 block_id, UInt8 *counts);
+
+	UInt32 search_block_1(UInt32 left, UInt32 right, UInt32 count) const;
+	UInt32 search_block_0(UInt32 left, UInt32 right, UInt32 count) const;
+
+	UInt32 select_1_in_block(UInt32 global_id, UInt32 count) const;
+	UInt32 select_0_in_block(UInt32 global_id, UInt32 count) const;
 
 	static UInt32 pop_count(UInt32 unit);
 };
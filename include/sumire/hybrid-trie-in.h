@@ -0,0 +1,288 @@
+#ifndef SUMIRE_HYBRID_TRIE_IN_H
+#define SUMIRE_HYBRID_TRIE_IN_H
+
+#include "hybrid-trie-top-view.h"
+
+#include <algorithm>
+#include <cassert>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace sumire {
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(
+	const TrieBase &trie)
+{
+	return build(trie, DEFAULT_NUM_DA_LEVELS);
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(
+	const TrieBase &trie, UInt32 num_da_levels)
+{
+	LoudsPlusTrie<SuccinctBitVector> louds;
+	if (!louds.build(trie))
+		return false;
+
+	// Nodes of LoudsPlusTrie are arranged in level order, and thus the top
+	// levels are a prefix of its indices.
+	UInt32 num_inner_nodes = 0;
+	UInt32 num_top_nodes = 1;
+	for (UInt32 level = 0; level < num_da_levels; ++level)
+	{
+		UInt32 num_next_nodes = num_top_nodes;
+		for (UInt32 index = num_inner_nodes; index < num_top_nodes; ++index)
+		{
+			for (UInt32 child_index = louds.child(index); child_index != 0;
+				child_index = louds.sibling(child_index))
+				++num_next_nodes;
+		}
+		num_inner_nodes = num_top_nodes;
+		num_top_nodes = num_next_nodes;
+	}
+
+	DaTrie da;
+	HybridTrieTopView top_view(louds, num_inner_nodes, num_top_nodes);
+	if (!da.build(top_view))
+		return false;
+
+	// Both tries are traversed in parallel to find the units of link nodes.
+	std::vector<std::pair<UInt32, UInt32> > link_pairs;
+	std::queue<std::pair<UInt32, UInt32> > queue;
+	queue.push(std::make_pair(da.root(), louds.root()));
+	while (!queue.empty())
+	{
+		UInt32 da_index = queue.front().first;
+		UInt32 louds_index = queue.front().second;
+		queue.pop();
+
+		if (louds_index >= num_inner_nodes)
+		{
+			if (louds.child(louds_index) != 0)
+				link_pairs.push_back(std::make_pair(da_index, louds_index));
+			continue;
+		}
+
+		for (UInt32 child_index = louds.child(louds_index); child_index != 0;
+			child_index = louds.sibling(child_index))
+		{
+			UInt32 da_child_index =
+				da.find_child(da_index, louds.label(child_index));
+			assert(da_child_index != 0);
+
+			queue.push(std::make_pair(da_child_index, child_index));
+		}
+	}
+	std::sort(link_pairs.begin(), link_pairs.end());
+
+	BitVector link_bv(BitVector::CONTIGUOUS_STORAGE);
+	link_bv.reserve(da.num_units());
+
+	ObjectArray<UInt32> links;
+	links.resize(static_cast<UInt32>(link_pairs.size()));
+
+	UInt32 link_id = 0;
+	for (UInt32 index = 0; index < da.num_units(); ++index)
+	{
+		bool is_link = (link_id < links.num_objs()) &&
+			(link_pairs[link_id].first == index);
+		if (is_link)
+		{
+			links[link_id] = link_pairs[link_id].second;
+			++link_id;
+		}
+		link_bv.add(is_link);
+	}
+	assert(link_id == links.num_objs());
+
+	SuccinctBitVector link_sbv;
+	link_sbv.build(&link_bv);
+
+	clear();
+	da_.swap(&da);
+	louds_.swap(&louds);
+	link_sbv_.swap(&link_sbv);
+	links_.swap(&links);
+
+	return true;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::find_child(
+	UInt32 index, UInt8 child_label) const
+{
+	assert(index < num_units());
+
+	if (index < da_.num_units())
+	{
+		if (!link_sbv_[index])
+			return da_.find_child(index, child_label);
+		index = link(index);
+	}
+	else
+		index -= da_.num_units();
+
+	return to_hybrid_index(louds_.find_child(index, child_label));
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::child(
+	UInt32 index) const
+{
+	assert(index < num_units());
+
+	if (index < da_.num_units())
+	{
+		if (!link_sbv_[index])
+			return da_.child(index);
+		index = link(index);
+	}
+	else
+		index -= da_.num_units();
+
+	return to_hybrid_index(louds_.child(index));
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::sibling(
+	UInt32 index) const
+{
+	assert(index < num_units());
+
+	if (index < da_.num_units())
+		return da_.sibling(index);
+
+	return to_hybrid_index(louds_.sibling(index - da_.num_units()));
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt8 HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::label(
+	UInt32 index) const
+{
+	assert(index < num_units());
+
+	if (index < da_.num_units())
+		return da_.label(index);
+
+	return louds_.label(index - da_.num_units());
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::get_value(
+	UInt32 index, UInt32 *value_ptr) const
+{
+	assert(index < num_units());
+
+	if (index < da_.num_units())
+		return da_.get_value(index, value_ptr);
+
+	return louds_.get_value(index - da_.num_units(), value_ptr);
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::size() const
+{
+	return da_.size() + louds_.size() + link_sbv_.size() + links_.size();
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline void HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::clear()
+{
+	da_.clear();
+	louds_.clear();
+	link_sbv_.clear();
+	links_.clear();
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline void *HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::map(void *addr)
+{
+	assert(addr != NULL);
+
+	clear();
+
+	addr = da_.map(addr);
+	addr = louds_.map(addr);
+	addr = link_sbv_.map(addr);
+	addr = links_.map(addr);
+
+	return addr;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::read(std::istream *input)
+{
+	assert(input != NULL);
+
+	DaTrie da;
+	if (!da.read(input))
+		return false;
+
+	LoudsPlusTrie<SuccinctBitVector> louds;
+	if (!louds.read(input))
+		return false;
+
+	SuccinctBitVector link_sbv;
+	ObjectArray<UInt32> links;
+	if (!link_sbv.read(input) || !links.read(input))
+		return false;
+
+	clear();
+	da_.swap(&da);
+	louds_.swap(&louds);
+	link_sbv_.swap(&link_sbv);
+	links_.swap(&links);
+
+	return true;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::write(
+	std::ostream *output) const
+{
+	assert(output != NULL);
+
+	if (!da_.write(output) || !louds_.write(output))
+		return false;
+
+	if (!link_sbv_.write(output) || !links_.write(output))
+		return false;
+
+	return true;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline void HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::swap(HybridTrie *target)
+{
+	assert(target != NULL);
+
+	da_.swap(&target->da_);
+	louds_.swap(&target->louds_);
+	link_sbv_.swap(&target->link_sbv_);
+	links_.swap(&target->links_);
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::link(UInt32 index) const
+{
+	assert(link_sbv_[index]);
+
+	UInt32 link_id = link_sbv_.rank_1(index) - 1;
+	assert(link_id < links_.num_objs());
+
+	return links_[link_id];
+}
+
+// The root of louds_ is never a child, so 0 is kept as it is.
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 HybridTrie<SUCCINCT_BIT_VECTOR_TYPE>::to_hybrid_index(
+	UInt32 louds_index) const
+{
+	return (louds_index != 0) ? (da_.num_units() + louds_index) : 0;
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_HYBRID_TRIE_IN_H
@@ -0,0 +1,57 @@
+#ifndef SUMIRE_HYBRID_TRIE_TOP_VIEW_H
+#define SUMIRE_HYBRID_TRIE_TOP_VIEW_H
+
+#include "trie-base.h"
+
+namespace sumire {
+
+// HybridTrieTopView shows the top levels of a trie whose nodes are indexed
+// in level order, such as LoudsPlusTrie. Nodes whose indices are less than
+// num_inner_nodes keep their children, and the other nodes are leaves.
+class HybridTrieTopView : public TrieBase
+{
+public:
+	HybridTrieTopView(const TrieBase &trie, UInt32 num_inner_nodes,
+		UInt32 num_nodes) : trie_(&trie), num_inner_nodes_(num_inner_nodes),
+		num_nodes_(num_nodes) {}
+	~HybridTrieTopView() {}
+
+	bool build(const TrieBase &trie) { return false; }
+
+	UInt32 find_child(UInt32 index, UInt8 child_label) const
+	{
+		return (index < num_inner_nodes_) ?
+			trie_->find_child(index, child_label) : 0;
+	}
+
+	UInt32 child(UInt32 index) const
+	{ return (index < num_inner_nodes_) ? trie_->child(index) : 0; }
+	UInt32 sibling(UInt32 index) const { return trie_->sibling(index); }
+	UInt8 label(UInt32 index) const { return trie_->label(index); }
+
+	bool get_value(UInt32 index, UInt32 *value_ptr = NULL) const
+	{ return trie_->get_value(index, value_ptr); }
+
+	UInt32 num_units() const { return num_nodes_; }
+	UInt32 num_nodes() const { return num_nodes_; }
+	UInt32 num_keys() const { return trie_->num_keys(); }
+	UInt32 size() const { return 0; }
+
+	void clear() {}
+	void *map(void *addr) { return addr; }
+	bool read(std::istream *input) { return false; }
+	bool write(std::ostream *output) const { return false; }
+
+private:
+	const TrieBase *trie_;
+	UInt32 num_inner_nodes_;
+	UInt32 num_nodes_;
+
+	// Disallows copies.
+	HybridTrieTopView(const HybridTrieTopView &);
+	HybridTrieTopView &operator=(const HybridTrieTopView &);
+};
+
+}  // namespace sumire
+
+#endif  // SUMIRE_HYBRID_TRIE_TOP_VIEW_H
@@ -0,0 +1,74 @@
+#ifndef SUMIRE_HYBRID_TRIE_H
+#define SUMIRE_HYBRID_TRIE_H
+
+#include "basic-succinct-bit-vector.h"
+#include "da-trie.h"
+#include "louds-plus-trie.h"
+#include "object-array.h"
+#include "trie-base.h"
+
+namespace sumire {
+
+// HybridTrie places the nodes of the top levels in a double-array, and the
+// whole trie in a LOUDS++ trie. Nodes on the deepest level of the
+// double-array that have children are link nodes, and links_ keeps their
+// indices in the LOUDS++ trie.
+//
+// Indices less than the number of double-array units are indices in da_,
+// and the other indices are those in louds_ plus the number of units.
+template <typename SUCCINCT_BIT_VECTOR_TYPE = BasicSuccinctBitVector>
+class HybridTrie : public TrieBase
+{
+public:
+	typedef SUCCINCT_BIT_VECTOR_TYPE SuccinctBitVector;
+
+	enum { DEFAULT_NUM_DA_LEVELS = 3 };
+
+	HybridTrie() : da_(), louds_(), link_sbv_(), links_() {}
+	~HybridTrie() { clear(); }
+
+	bool build(const TrieBase &trie);
+	bool build(const TrieBase &trie, UInt32 num_da_levels);
+
+	UInt32 find_child(UInt32 index, UInt8 child_label) const;
+
+	UInt32 child(UInt32 index) const;
+	UInt32 sibling(UInt32 index) const;
+	UInt8 label(UInt32 index) const;
+
+	bool get_value(UInt32 index, UInt32 *value_ptr = NULL) const;
+
+	UInt32 num_units() const { return da_.num_units() + louds_.num_units(); }
+	UInt32 num_nodes() const { return louds_.num_nodes(); }
+	UInt32 num_da_nodes() const { return da_.num_nodes(); }
+	UInt32 num_links() const { return links_.num_objs(); }
+	UInt32 num_keys() const { return louds_.num_keys(); }
+	UInt32 size() const;
+
+	void clear();
+	void *map(void *addr);
+	bool read(std::istream *input);
+	bool write(std::ostream *output) const;
+
+	void swap(HybridTrie *target);
+
+private:
+	DaTrie da_;
+	LoudsPlusTrie<SuccinctBitVector> louds_;
+	SuccinctBitVector link_sbv_;
+	ObjectArray<UInt32> links_;
+
+	// Disallows copies.
+	HybridTrie(const HybridTrie &);
+	HybridTrie &operator=(const HybridTrie &);
+
+	// Returns the index in louds_ of a link node.
+	UInt32 link(UInt32 index) const;
+	UInt32 to_hybrid_index(UInt32 louds_index) const;
+};
+
+}  // namespace sumire
+
+#include "hybrid-trie-in.h"
+
+#endif  // SUMIRE_HYBRID_TRIE_H
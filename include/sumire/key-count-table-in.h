@@ -0,0 +1,159 @@
+#ifndef SUMIRE_KEY_COUNT_TABLE_IN_H
+#define SUMIRE_KEY_COUNT_TABLE_IN_H
+
+#include <cassert>
+#include <vector>
+
+namespace sumire {
+
+// Nodes are listed in preorder, and then visited in reverse order so that
+// every child is done before its parent.
+inline void KeyCountTable::build(const TrieBase &trie, Content content)
+{
+	ObjectArray<UInt32> num_keys;
+	num_keys.resize(trie.num_units());
+	for (UInt32 index = 0; index < num_keys.num_objs(); ++index)
+		num_keys[index] = 0;
+
+	ObjectArray<UInt64> sums;
+	if (content == KEY_COUNTS_AND_VALUE_SUMS)
+	{
+		sums.resize(trie.num_units());
+		for (UInt32 index = 0; index < sums.num_objs(); ++index)
+			sums[index] = 0;
+	}
+
+	std::vector<UInt32> indices;
+	std::vector<UInt32> stack;
+	if (trie.num_nodes() != 0)
+		stack.push_back(trie.root());
+	while (!stack.empty())
+	{
+		UInt32 index = stack.back();
+		stack.pop_back();
+		indices.push_back(index);
+
+		for (UInt32 child_index = trie.child(index); child_index != 0;
+			child_index = trie.sibling(child_index))
+			stack.push_back(child_index);
+	}
+
+	for (std::size_t i = indices.size(); i > 0; --i)
+	{
+		UInt32 index = indices[i - 1];
+
+		UInt32 value;
+		bool has_value = trie.get_value(index, &value);
+		if (has_value)
+			num_keys[index] = 1;
+		for (UInt32 child_index = trie.child(index); child_index != 0;
+			child_index = trie.sibling(child_index))
+			num_keys[index] += num_keys[child_index];
+
+		if (sums.num_objs() != 0)
+		{
+			if (has_value)
+				sums[index] = value;
+			for (UInt32 child_index = trie.child(index); child_index != 0;
+				child_index = trie.sibling(child_index))
+				sums[index] += sums[child_index];
+		}
+	}
+
+	clear();
+	num_keys_.swap(&num_keys);
+	sums_.swap(&sums);
+}
+
+inline UInt32 KeyCountTable::num_keys(UInt32 index) const
+{
+	assert(index < num_units());
+
+	return num_keys_[index];
+}
+
+inline UInt64 KeyCountTable::sum_values(UInt32 index) const
+{
+	assert(has_value_sums());
+	assert(index < num_units());
+
+	return sums_[index];
+}
+
+inline UInt32 KeyCountTable::count_keys(const TrieBase &trie,
+	const char *prefix) const
+{
+	assert(trie.num_units() == num_units());
+
+	UInt32 index;
+	if (num_units() == 0 || !trie.follow(trie.root(), prefix, &index))
+		return 0;
+	return num_keys(index);
+}
+
+inline UInt64 KeyCountTable::sum_values(const TrieBase &trie,
+	const char *prefix) const
+{
+	assert(trie.num_units() == num_units());
+
+	UInt32 index;
+	if (num_units() == 0 || !trie.follow(trie.root(), prefix, &index))
+		return 0;
+	return sum_values(index);
+}
+
+inline void KeyCountTable::clear()
+{
+	num_keys_.clear();
+	sums_.clear();
+}
+
+inline void *KeyCountTable::map(void *addr)
+{
+	assert(addr != NULL);
+
+	clear();
+
+	addr = num_keys_.map(addr);
+	addr = sums_.map(addr);
+
+	return addr;
+}
+
+inline bool KeyCountTable::read(std::istream *input)
+{
+	assert(input != NULL);
+
+	ObjectArray<UInt32> num_keys;
+	ObjectArray<UInt64> sums;
+	if (!num_keys.read(input) || !sums.read(input))
+		return false;
+
+	clear();
+	num_keys_.swap(&num_keys);
+	sums_.swap(&sums);
+
+	return true;
+}
+
+inline bool KeyCountTable::write(std::ostream *output) const
+{
+	assert(output != NULL);
+
+	if (!num_keys_.write(output) || !sums_.write(output))
+		return false;
+
+	return true;
+}
+
+inline void KeyCountTable::swap(KeyCountTable *target)
+{
+	assert(target != NULL);
+
+	num_keys_.swap(&target->num_keys_);
+	sums_.swap(&target->sums_);
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_KEY_COUNT_TABLE_IN_H
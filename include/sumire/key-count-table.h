@@ -0,0 +1,59 @@
+#ifndef SUMIRE_KEY_COUNT_TABLE_H
+#define SUMIRE_KEY_COUNT_TABLE_H
+
+#include "object-array.h"
+#include "trie-base.h"
+
+namespace sumire {
+
+// KeyCountTable keeps the number of keys and the sum of their values in
+// the subtree of each unit of a trie, so that the keys that start with a
+// prefix are counted without enumeration.
+class KeyCountTable
+{
+public:
+	// Sums take 8 bytes per unit in addition to 4 bytes for counts, so
+	// only counts are kept by default.
+	enum Content
+	{
+		KEY_COUNTS,
+		KEY_COUNTS_AND_VALUE_SUMS
+	};
+
+	KeyCountTable() : num_keys_(), sums_() {}
+	~KeyCountTable() { clear(); }
+
+	void build(const TrieBase &trie, Content content = KEY_COUNTS);
+
+	UInt32 num_keys(UInt32 index) const;
+	UInt64 sum_values(UInt32 index) const;
+
+	// Follows a prefix from the root, and returns 0 if it is not in the trie.
+	UInt32 count_keys(const TrieBase &trie, const char *prefix) const;
+	UInt64 sum_values(const TrieBase &trie, const char *prefix) const;
+
+	bool has_value_sums() const { return sums_.num_objs() != 0; }
+	UInt32 num_units() const { return num_keys_.num_objs(); }
+	UInt32 size() const { return num_keys_.size() + sums_.size(); }
+
+	void clear();
+	void *map(void *addr);
+	bool read(std::istream *input);
+	bool write(std::ostream *output) const;
+
+	void swap(KeyCountTable *target);
+
+private:
+	ObjectArray<UInt32> num_keys_;
+	ObjectArray<UInt64> sums_;
+
+	// Disallows copies.
+	KeyCountTable(const KeyCountTable &);
+	KeyCountTable &operator=(const KeyCountTable &);
+};
+
+}  // namespace sumire
+
+#include "key-count-table-in.h"
+
+#endif  // SUMIRE_KEY_COUNT_TABLE_H
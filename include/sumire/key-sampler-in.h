@@ -0,0 +1,136 @@
+#ifndef SUMIRE_KEY_SAMPLER_IN_H
+#define SUMIRE_KEY_SAMPLER_IN_H
+
+#include <cassert>
+
+namespace sumire {
+
+inline bool KeySampler::start(const TrieBase &trie,
+	const KeyCountTable &table, UInt32 index, Weight weight)
+{
+	if (trie.num_units() == 0)
+		return false;
+
+	assert(index < trie.num_units());
+	assert(table.num_units() == trie.num_units());
+	assert(weight != VALUE_WEIGHT || table.has_value_sums());
+
+	clear();
+
+	trie_ = &trie;
+	table_ = &table;
+	index_ = index;
+	weight_ = weight;
+
+	return true;
+}
+
+// The first draw gives the highest bits of a position and the others give
+// RANDOM_BITS bits each. A position out of range is drawn again, which
+// happens less than half the time.
+template <typename RNG_TYPE>
+bool KeySampler::next(RNG_TYPE *rng)
+{
+	assert(trie_ != NULL);
+	assert(rng != NULL);
+
+	UInt64 total = total_weight();
+	if (total == 0)
+		return false;
+
+	UInt32 num_low_draws = 0;
+	while (((total - 1) >> (RANDOM_BITS * num_low_draws)) >=
+		(static_cast<UInt64>(1) << RANDOM_BITS))
+		++num_low_draws;
+	UInt64 high_bound = ((total - 1) >> (RANDOM_BITS * num_low_draws)) + 1;
+
+	UInt64 position;
+	do
+	{
+		position = static_cast<UInt64>((*rng)(high_bound));
+		for (UInt32 i = 0; i < num_low_draws; ++i)
+		{
+			position = (position << RANDOM_BITS) |
+				static_cast<UInt64>((*rng)(1 << RANDOM_BITS));
+		}
+	} while (position >= total);
+
+	return pick(position);
+}
+
+// The position is compared with the weights of the node itself and its
+// children in order, and the remainder is passed to the chosen child.
+inline bool KeySampler::pick(UInt64 position)
+{
+	assert(trie_ != NULL);
+
+	if (position >= total_weight())
+		return false;
+
+	key_.clear();
+
+	UInt32 index = index_;
+	for ( ; ; )
+	{
+		UInt32 value;
+		if (trie_->get_value(index, &value))
+		{
+			UInt64 key_weight = (weight_ == UNIFORM_WEIGHT) ? 1 : value;
+			if (position < key_weight)
+			{
+				value_ = value;
+				break;
+			}
+			position -= key_weight;
+		}
+
+		UInt32 child_index = trie_->child(index);
+		while (child_index != 0 && position >= weight(child_index))
+		{
+			position -= weight(child_index);
+			child_index = trie_->sibling(child_index);
+		}
+		assert(child_index != 0);
+
+		key_.push_back(static_cast<char>(trie_->label(child_index)));
+		index = child_index;
+	}
+	key_.push_back('\0');
+
+	return true;
+}
+
+inline const char *KeySampler::key() const
+{
+	assert(key_.size() > 0);
+
+	return &key_[0];
+}
+
+inline UInt64 KeySampler::total_weight() const
+{
+	assert(trie_ != NULL);
+
+	return weight(index_);
+}
+
+inline void KeySampler::clear()
+{
+	trie_ = NULL;
+	table_ = NULL;
+	index_ = 0;
+	weight_ = UNIFORM_WEIGHT;
+	key_.clear();
+	value_ = TrieBase::INVALID_VALUE;
+}
+
+inline UInt64 KeySampler::weight(UInt32 index) const
+{
+	if (weight_ == UNIFORM_WEIGHT)
+		return table_->num_keys(index);
+	return table_->sum_values(index);
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_KEY_SAMPLER_IN_H
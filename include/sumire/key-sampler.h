@@ -0,0 +1,75 @@
+#ifndef SUMIRE_KEY_SAMPLER_H
+#define SUMIRE_KEY_SAMPLER_H
+
+#include "key-count-table.h"
+#include "trie-base.h"
+
+#include <vector>
+
+namespace sumire {
+
+// KeySampler picks keys in the subtree of a node at random. It descends
+// from the node with one random number, and subtracts the count of each
+// skipped child from it, so that a key is picked without rejection in
+// O(depth * fanout) time, independently of the size of the subtree.
+class KeySampler
+{
+public:
+	// VALUE_WEIGHT picks a key in proportion to its value, and requires a
+	// KeyCountTable with value sums.
+	enum Weight
+	{
+		UNIFORM_WEIGHT,
+		VALUE_WEIGHT
+	};
+
+	KeySampler() : trie_(NULL), table_(NULL), index_(0),
+		weight_(UNIFORM_WEIGHT), key_(), value_(TrieBase::INVALID_VALUE) {}
+	~KeySampler() { clear(); }
+
+	// The table must be built from the same trie.
+	bool start(const TrieBase &trie, const KeyCountTable &table,
+		UInt32 index, Weight weight = UNIFORM_WEIGHT);
+
+	// Picks a key, and fails if the subtree has no key to pick. (*rng)(n)
+	// must return a random integer in [0, n) for n up to 2^30, as for
+	// std::random_shuffle(). A greater position is composed of draws of
+	// 30 bits, so an RNG that takes and returns int is enough.
+	template <typename RNG_TYPE>
+	bool next(RNG_TYPE *rng);
+
+	// Picks the key at a position in [0, total_weight()). A uniform
+	// position gives a uniform sample.
+	bool pick(UInt64 position);
+
+	const char *key() const;
+	UInt32 length() const { return key_.size() - 1; }
+	UInt32 value() const { return value_; }
+
+	// The number of keys, or the sum of their values, in the subtree.
+	UInt64 total_weight() const;
+
+	void clear();
+
+private:
+	const TrieBase *trie_;
+	const KeyCountTable *table_;
+	UInt32 index_;
+	Weight weight_;
+	std::vector<char> key_;
+	UInt32 value_;
+
+	enum { RANDOM_BITS = 30 };
+
+	// Disallows copies.
+	KeySampler(const KeySampler &);
+	KeySampler &operator=(const KeySampler &);
+
+	UInt64 weight(UInt32 index) const;
+};
+
+}  // namespace sumire
+
+#include "key-sampler-in.h"
+
+#endif  // SUMIRE_KEY_SAMPLER_H
@@ -0,0 +1,121 @@
+#ifndef SUMIRE_LABEL_SCANNER_IN_H
+#define SUMIRE_LABEL_SCANNER_IN_H
+
+#include <cassert>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif  // defined(__AVX2__)
+
+namespace sumire {
+
+inline UInt32 LabelScanner::scan(const UInt8 *labels,
+	const BasicTrieUnit *units, UInt32 num_units, UInt8 label)
+{
+	assert(labels != NULL || num_units == 0);
+	assert(units != NULL || num_units == 0);
+
+	// Most runs are short, so the first unit is tested before vectors.
+	if (num_units == 0 || labels[0] == label || !units[0].has_sibling())
+		return 0;
+
+	UInt32 offset = 1;
+
+#if defined(__AVX2__)
+	// The lowest bit of each unit is its sibling flag, and it is moved to
+	// the sign bit so that MOVMSKPS gathers 8 flags at once.
+	const __m256i label_vector = _mm256_set1_epi8(static_cast<char>(label));
+	for ( ; offset + 32 <= num_units; offset += 32)
+	{
+		const UInt32 *flags = reinterpret_cast<const UInt32 *>(units + offset);
+		UInt32 has_siblings = 0;
+		for (UInt32 i = 0; i < 4; ++i)
+		{
+			__m256i unit_vector = _mm256_slli_epi32(_mm256_loadu_si256(
+				reinterpret_cast<const __m256i *>(flags + (i * 8))), 31);
+			has_siblings |= static_cast<UInt32>(_mm256_movemask_ps(
+				_mm256_castsi256_ps(unit_vector))) << (i * 8);
+		}
+		UInt32 matches = static_cast<UInt32>(_mm256_movemask_epi8(
+			_mm256_cmpeq_epi8(label_vector, _mm256_loadu_si256(
+			reinterpret_cast<const __m256i *>(labels + offset)))));
+
+		UInt32 hits = matches | ~has_siblings;
+		if (hits != 0)
+			return offset + __builtin_ctz(hits);
+	}
+#elif defined(__SSE2__)
+	const __m128i label_vector = _mm_set1_epi8(static_cast<char>(label));
+	for ( ; offset + 16 <= num_units; offset += 16)
+	{
+		const UInt32 *flags = reinterpret_cast<const UInt32 *>(units + offset);
+		UInt32 has_siblings = 0;
+		for (UInt32 i = 0; i < 4; ++i)
+		{
+			__m128i unit_vector = _mm_slli_epi32(_mm_loadu_si128(
+				reinterpret_cast<const __m128i *>(flags + (i * 4))), 31);
+			has_siblings |= static_cast<UInt32>(_mm_movemask_ps(
+				_mm_castsi128_ps(unit_vector))) << (i * 4);
+		}
+		UInt32 matches = static_cast<UInt32>(_mm_movemask_epi8(
+			_mm_cmpeq_epi8(label_vector, _mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(labels + offset)))));
+
+		UInt32 hits = (matches | ~has_siblings) & 0xFFFF;
+		if (hits != 0)
+			return offset + __builtin_ctz(hits);
+	}
+#endif  // defined(__AVX2__)
+
+	for ( ; offset < num_units; ++offset)
+	{
+		if (labels[offset] == label || !units[offset].has_sibling())
+			return offset;
+	}
+	return num_units;
+}
+
+inline UInt32 LabelScanner::find(const UInt8 *labels, UInt32 num_labels,
+	UInt8 label)
+{
+	assert(labels != NULL || num_labels == 0);
+
+	UInt32 offset = 0;
+
+#if defined(__AVX2__)
+	const __m256i label_vector = _mm256_set1_epi8(static_cast<char>(label));
+	for ( ; offset + 32 <= num_labels; offset += 32)
+	{
+		UInt32 matches = static_cast<UInt32>(_mm256_movemask_epi8(
+			_mm256_cmpeq_epi8(label_vector, _mm256_loadu_si256(
+			reinterpret_cast<const __m256i *>(labels + offset)))));
+		if (matches != 0)
+			return offset + __builtin_ctz(matches);
+	}
+#endif  // defined(__AVX2__)
+
+#if defined(__SSE2__)
+	const __m128i label_vector_16 = _mm_set1_epi8(static_cast<char>(label));
+	for ( ; offset + 16 <= num_labels; offset += 16)
+	{
+		UInt32 matches = static_cast<UInt32>(_mm_movemask_epi8(
+			_mm_cmpeq_epi8(label_vector_16, _mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(labels + offset)))));
+		if (matches != 0)
+			return offset + __builtin_ctz(matches);
+	}
+#endif  // defined(__SSE2__)
+
+	for ( ; offset < num_labels; ++offset)
+	{
+		if (labels[offset] == label)
+			return offset;
+	}
+	return num_labels;
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_LABEL_SCANNER_IN_H
@@ -0,0 +1,38 @@
+#ifndef SUMIRE_LABEL_SCANNER_H
+#define SUMIRE_LABEL_SCANNER_H
+
+#include "basic-trie-unit.h"
+
+namespace sumire {
+
+// LabelScanner searches a run of siblings, which are stored in consecutive
+// units, for a label. SSE2 or AVX2 is used if enabled at compile time, and
+// then 16 or 32 labels (and sibling flags) are tested at once.
+class LabelScanner
+{
+public:
+	// Returns the offset of the first unit that has the label or ends the
+	// run. If there is no such unit in the first num_units units, returns
+	// num_units.
+	static UInt32 scan(const UInt8 *labels, const BasicTrieUnit *units,
+		UInt32 num_units, UInt8 label);
+
+	// Returns the offset of the label in the first num_labels labels. If
+	// there is no such label, returns num_labels.
+	static UInt32 find(const UInt8 *labels, UInt32 num_labels, UInt8 label);
+
+private:
+	// Disallows instantiation.
+	LabelScanner() {}
+	~LabelScanner() {}
+
+	// Disallows copies.
+	LabelScanner(const LabelScanner &);
+	LabelScanner &operator=(const LabelScanner &);
+};
+
+}  // namespace sumire
+
+#include "label-scanner-in.h"
+
+#endif  // SUMIRE_LABEL_SCANNER_H
@@ -1,6 +1,7 @@
 #ifndef SUMIRE_LOUDS_PLUS_TRIE_IN_H
 #define SUMIRE_LOUDS_PLUS_TRIE_IN_H
 
+#include "label-scanner.h"
 #include "object-io.h"
 
 #include <cassert>
@@ -15,7 +16,16 @@ inline bool LoudsPlusTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(
 	if (trie.num_nodes() == 0)
 		return false;
 
-	BitVector child_bv, sibling_bv, has_value_bv;
+	BitVector child_bv(BitVector::CONTIGUOUS_STORAGE);
+	BitVector sibling_bv(BitVector::CONTIGUOUS_STORAGE);
+	BitVector has_value_bv(BitVector::CONTIGUOUS_STORAGE);
+	child_bv.reserve(trie.num_nodes());
+	sibling_bv.reserve(trie.num_nodes());
+	has_value_bv.reserve(trie.num_nodes());
+
+	// Sibling bits are emitted per child run, which is consecutive in level
+	// order, and thus the root's bit goes first.
+	sibling_bv.add(false);
 
 	ObjectArray<UInt8> labels;
 	ObjectArray<UInt32> values;
@@ -43,12 +53,15 @@ inline bool LoudsPlusTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(
 		UInt32 child_index = trie.child(index);
 		child_bv.add(child_index != 0);
 
+		UInt32 num_children = 0;
 		while (child_index != 0)
 		{
 			queue.push(child_index);
 			child_index = trie.sibling(child_index);
+			++num_children;
 		}
-		sibling_bv.add(trie.sibling(index) != 0);
+		if (num_children != 0)
+			sibling_bv.append_unary(num_children - 1);
 	}
 
 	assert(child_bv.num_bits() == trie.num_nodes());
@@ -58,9 +71,9 @@ inline bool LoudsPlusTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(
 	assert(value_index == values.num_objs());
 
 	SuccinctBitVector child_sbv, sibling_sbv, has_value_sbv;
-	child_sbv.build(child_bv);
-	sibling_sbv.build(sibling_bv);
-	has_value_sbv.build(has_value_bv);
+	child_sbv.build(&child_bv);
+	sibling_sbv.build(&sibling_bv);
+	has_value_sbv.build(&has_value_bv);
 
 	clear();
 	child_sbv_.swap(&child_sbv);
@@ -78,13 +91,15 @@ inline UInt32 LoudsPlusTrie<SUCCINCT_BIT_VECTOR_TYPE>::find_child(
 {
 	assert(index < num_units());
 
-	for (UInt32 child_index = child(index); child_index != 0;
-		child_index = sibling(child_index))
-	{
-		if (label(child_index) == child_label)
-			return child_index;
-	}
-	return 0;
+	UInt32 child_index = child(index);
+	if (child_index == 0)
+		return 0;
+
+	// The last child of each run has no sibling bit.
+	UInt32 num_children = sibling_sbv_.run_length_1(child_index) + 1;
+	UInt32 offset = LabelScanner::find(&labels_[child_index],
+		num_children, child_label);
+	return (offset < num_children) ? (child_index + offset) : 0;
 }
 
 template <typename SUCCINCT_BIT_VECTOR_TYPE>
@@ -1,6 +1,7 @@
 #ifndef SUMIRE_LOUDS_TRIE_IN_H
 #define SUMIRE_LOUDS_TRIE_IN_H
 
+#include "label-scanner.h"
 #include "object-io.h"
 
 #include <cassert>
@@ -14,9 +15,11 @@ inline bool LoudsTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(const TrieBase &trie)
 	if (trie.num_nodes() == 0)
 		return false;
 
-	BitVector louds_bv, has_value_bv;
-	louds_bv.add(true);
-	louds_bv.add(false);
+	BitVector louds_bv(BitVector::CONTIGUOUS_STORAGE);
+	BitVector has_value_bv(BitVector::CONTIGUOUS_STORAGE);
+	louds_bv.reserve((trie.num_nodes() * 2) + 1);
+	has_value_bv.reserve(trie.num_nodes());
+	louds_bv.append_unary(1);
 
 	ObjectArray<UInt8> labels;
 	ObjectArray<UInt32> values;
@@ -41,13 +44,14 @@ inline bool LoudsTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(const TrieBase &trie)
 			values[value_index++] = value;
 		has_value_bv.add(has_value);
 
+		UInt32 num_children = 0;
 		for (UInt32 child_index = trie.child(index); child_index != 0;
 			child_index = trie.sibling(child_index))
 		{
-			louds_bv.add(true);
 			queue.push(child_index);
+			++num_children;
 		}
-		louds_bv.add(false);
+		louds_bv.append_unary(num_children);
 	}
 
 	assert(louds_bv.num_bits() == (trie.num_nodes() * 2) + 1);
@@ -56,8 +60,8 @@ inline bool LoudsTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(const TrieBase &trie)
 	assert(value_index == values.num_objs());
 
 	SuccinctBitVector louds_sbv, has_value_sbv;
-	louds_sbv.build(louds_bv);
-	has_value_sbv.build(has_value_bv);
+	louds_sbv.build(&louds_bv);
+	has_value_sbv.build(&has_value_bv);
 
 	clear();
 	louds_sbv_.swap(&louds_sbv);
@@ -72,19 +76,19 @@ template <typename SUCCINCT_BIT_VECTOR_TYPE>
 inline UInt32 LoudsTrie<SUCCINCT_BIT_VECTOR_TYPE>::find_child(
 	UInt32 index, UInt8 child_label) const
 {
-	UInt32 child_index = child(index);
-	if (child_index != 0)
-	{
-		UInt32 node_index = louds_sbv_.rank_1(child_index) - 1;
-		do
-		{
-			if (labels_[node_index] == child_label)
-				return child_index;
-			child_index = sibling(child_index);
-			++node_index;
-		} while (child_index != 0);
-	}
-	return 0;
+	assert(index < num_units());
+
+	// Children are a run of 1s in louds_sbv_ and consecutive in labels_,
+	// so the run is measured once and its labels are searched at once.
+	UInt32 child_count = louds_sbv_.rank_1(index);
+	UInt32 child_index = louds_sbv_.select_0(child_count) + 1;
+	UInt32 num_children = louds_sbv_.run_length_1(child_index);
+	if (num_children == 0)
+		return 0;
+
+	UInt32 offset = LabelScanner::find(&labels_[child_index - child_count],
+		num_children, child_label);
+	return (offset < num_children) ? (child_index + offset) : 0;
 }
 
 template <typename SUCCINCT_BIT_VECTOR_TYPE>
@@ -0,0 +1,140 @@
+#ifndef SUMIRE_MAX_VALUE_TABLE_IN_H
+#define SUMIRE_MAX_VALUE_TABLE_IN_H
+
+#include "object-io.h"
+
+#include <cassert>
+#include <vector>
+
+namespace sumire {
+
+// Nodes are listed in preorder, and then visited in reverse order so that
+// every child is done before its parent.
+inline void MaxValueTable::build(const TrieBase &trie)
+{
+	ObjectArray<UInt32> max_values;
+	max_values.resize(trie.num_units());
+	for (UInt32 index = 0; index < max_values.num_objs(); ++index)
+		max_values[index] = TrieBase::INVALID_VALUE;
+
+	std::vector<UInt32> indices;
+	std::vector<UInt32> stack;
+	if (trie.num_nodes() != 0)
+		stack.push_back(trie.root());
+	while (!stack.empty())
+	{
+		UInt32 index = stack.back();
+		stack.pop_back();
+		indices.push_back(index);
+
+		for (UInt32 child_index = trie.child(index); child_index != 0;
+			child_index = trie.sibling(child_index))
+			stack.push_back(child_index);
+	}
+
+	bool in_max_value_order = true;
+	for (std::size_t i = indices.size(); i > 0; --i)
+	{
+		UInt32 index = indices[i - 1];
+		UInt32 value = trie.value(index);
+		// The first child is compared with the greatest valid value.
+		UInt32 last_max_value = TrieBase::INVALID_VALUE - 1;
+		for (UInt32 child_index = trie.child(index); child_index != 0;
+			child_index = trie.sibling(child_index))
+		{
+			UInt32 child_max_value = max_values[child_index];
+			if (max_value(last_max_value, child_max_value) != last_max_value)
+				in_max_value_order = false;
+			last_max_value = child_max_value;
+			value = max_value(value, child_max_value);
+		}
+		max_values[index] = value;
+	}
+
+	clear();
+	max_values_.swap(&max_values);
+	in_max_value_order_ = in_max_value_order;
+}
+
+inline UInt32 MaxValueTable::operator[](UInt32 index) const
+{
+	assert(index < num_units());
+
+	return max_values_[index];
+}
+
+inline void MaxValueTable::clear()
+{
+	max_values_.clear();
+	in_max_value_order_ = false;
+}
+
+inline void *MaxValueTable::map(void *addr)
+{
+	assert(addr != NULL);
+
+	clear();
+
+	addr = max_values_.map(addr);
+
+	ObjectClipper clipper(addr);
+	in_max_value_order_ = (*clipper.clip<UInt32>() != 0);
+
+	return clipper.addr();
+}
+
+inline bool MaxValueTable::read(std::istream *input)
+{
+	assert(input != NULL);
+
+	ObjectArray<UInt32> max_values;
+	if (!max_values.read(input))
+		return false;
+
+	ObjectReader reader(input);
+
+	UInt32 in_max_value_order;
+	if (!reader.read(&in_max_value_order))
+		return false;
+
+	clear();
+	max_values_.swap(&max_values);
+	in_max_value_order_ = (in_max_value_order != 0);
+
+	return true;
+}
+
+inline bool MaxValueTable::write(std::ostream *output) const
+{
+	assert(output != NULL);
+
+	if (!max_values_.write(output))
+		return false;
+
+	ObjectWriter writer(output);
+	if (!writer.write(static_cast<UInt32>(in_max_value_order_ ? 1 : 0)))
+		return false;
+
+	return true;
+}
+
+inline void MaxValueTable::swap(MaxValueTable *target)
+{
+	assert(target != NULL);
+
+	max_values_.swap(&target->max_values_);
+	std::swap(in_max_value_order_, target->in_max_value_order_);
+}
+
+inline UInt32 MaxValueTable::max_value(UInt32 lhs, UInt32 rhs)
+{
+	if (lhs == TrieBase::INVALID_VALUE)
+		return rhs;
+	else if (rhs == TrieBase::INVALID_VALUE)
+		return lhs;
+	return (lhs > rhs) ? lhs : rhs;
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_MAX_VALUE_TABLE_IN_H
@@ -0,0 +1,52 @@
+#ifndef SUMIRE_MAX_VALUE_TABLE_H
+#define SUMIRE_MAX_VALUE_TABLE_H
+
+#include "object-array.h"
+#include "trie-base.h"
+
+namespace sumire {
+
+// MaxValueTable keeps the maximum value in the subtree of each unit of a
+// trie. Units without values in their subtrees get INVALID_VALUE.
+class MaxValueTable
+{
+public:
+	MaxValueTable() : max_values_(), in_max_value_order_(false) {}
+	~MaxValueTable() { clear(); }
+
+	void build(const TrieBase &trie);
+
+	UInt32 operator[](UInt32 index) const;
+
+	// Returns true if the siblings of the trie are in descending order of
+	// their maximum values, as in BasicTrie::MAX_VALUE_ORDER.
+	bool in_max_value_order() const { return in_max_value_order_; }
+
+	UInt32 num_units() const { return max_values_.num_objs(); }
+	UInt32 size() const { return max_values_.size(); }
+
+	void clear();
+	void *map(void *addr);
+	bool read(std::istream *input);
+	bool write(std::ostream *output) const;
+
+	void swap(MaxValueTable *target);
+
+	// Returns the greater of two values, either of which may be
+	// INVALID_VALUE.
+	static UInt32 max_value(UInt32 lhs, UInt32 rhs);
+
+private:
+	ObjectArray<UInt32> max_values_;
+	bool in_max_value_order_;
+
+	// Disallows copies.
+	MaxValueTable(const MaxValueTable &);
+	MaxValueTable &operator=(const MaxValueTable &);
+};
+
+}  // namespace sumire
+
+#include "max-value-table-in.h"
+
+#endif  // SUMIRE_MAX_VALUE_TABLE_H
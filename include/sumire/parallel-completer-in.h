@@ -0,0 +1,313 @@
+#ifndef SUMIRE_PARALLEL_COMPLETER_IN_H
+#define SUMIRE_PARALLEL_COMPLETER_IN_H
+
+#include "basic-completer.h"
+#include "value-order-completer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif  // _OPENMP
+
+namespace sumire {
+
+inline bool ParallelCompleter::start(const TrieBase &trie, UInt32 index)
+{
+	return start(trie, index, DICTIONARY_ORDER);
+}
+
+// In VALUE_ORDER, every range is filled in advance to know its first value.
+// In DICTIONARY_ORDER, ranges are filled when next() reaches them.
+inline bool ParallelCompleter::start(const TrieBase &trie, UInt32 index,
+	Order order, UInt32 max_num_results, UInt32 min_num_ranges,
+	UInt32 buffer_size)
+{
+	if (trie.num_units() == 0)
+		return false;
+
+	assert(index < trie.num_units());
+	assert(buffer_size > 0);
+
+	clear();
+
+	trie_ = &trie;
+	order_ = order;
+	max_num_results_ = max_num_results;
+	buffer_size_ = buffer_size;
+
+	split(index, min_num_ranges);
+
+	completers_.resize(range_indices_.size(), NULL);
+	range_keys_.resize(range_indices_.size());
+	range_values_.resize(range_indices_.size());
+	key_offsets_.resize(range_indices_.size(), 0);
+	positions_.resize(range_indices_.size(), 0);
+
+	for (UInt32 range_id = 0; range_id < num_ranges(); ++range_id)
+	{
+		if (!range_is_subtrees_[range_id])
+		{
+			range_keys_[range_id].push_back('\0');
+			range_values_[range_id].push_back(
+				trie_->value(range_indices_[range_id]));
+			continue;
+		}
+
+		if (order_ == DICTIONARY_ORDER)
+			completers_[range_id] = new BasicCompleter;
+		else
+			completers_[range_id] = new ValueOrderCompleter;
+		completers_[range_id]->start(*trie_, range_indices_[range_id]);
+	}
+
+	if (order_ == VALUE_ORDER)
+	{
+		for (UInt32 range_id = 0; range_id < num_ranges(); ++range_id)
+			fill_range_ids_.push_back(range_id);
+		fill_ranges();
+
+		for (UInt32 range_id = 0; range_id < num_ranges(); ++range_id)
+			push_candidate(range_id);
+	}
+
+	return true;
+}
+
+inline bool ParallelCompleter::next()
+{
+	assert(trie_ != NULL);
+
+	if (num_results_ >= max_num_results_)
+		return false;
+
+	UInt32 range_id;
+	if (order_ == DICTIONARY_ORDER)
+	{
+		while (range_id_ < num_ranges() && !has_key(range_id_))
+			++range_id_;
+		if (range_id_ == num_ranges())
+			return false;
+		range_id = range_id_;
+	}
+	else
+	{
+		// A candidate of a drained range has the last value of the range,
+		// which bounds its next value.
+		for ( ; ; )
+		{
+			if (candidates_.empty())
+				return false;
+			range_id = candidates_.front().index();
+			UInt32 value = candidates_.front().value();
+			std::pop_heap(candidates_.begin(), candidates_.end());
+			candidates_.pop_back();
+
+			if (!has_key(range_id))
+				continue;
+			if (range_values_[range_id][positions_[range_id]] == value)
+				break;
+			push_candidate(range_id);
+		}
+	}
+
+	const std::string &prefix = range_prefixes_[range_id];
+	const char *suffix = &range_keys_[range_id][key_offsets_[range_id]];
+	UInt32 suffix_length = static_cast<UInt32>(std::strlen(suffix));
+	key_buf_.assign(prefix.begin(), prefix.end());
+	key_buf_.insert(key_buf_.end(), suffix, suffix + suffix_length + 1);
+
+	key_ = &key_buf_[0];
+	length_ = static_cast<UInt32>(key_buf_.size() - 1);
+	value_ = range_values_[range_id][positions_[range_id]];
+
+	key_offsets_[range_id] += suffix_length + 1;
+	++positions_[range_id];
+	if (order_ == VALUE_ORDER)
+		push_candidate(range_id);
+
+	++num_results_;
+	return true;
+}
+
+inline void ParallelCompleter::clear()
+{
+	trie_ = NULL;
+	order_ = DICTIONARY_ORDER;
+	max_num_results_ = 0;
+	buffer_size_ = 0;
+	num_results_ = 0;
+	range_indices_.clear();
+	range_is_subtrees_.clear();
+	range_prefixes_.clear();
+	for (std::size_t i = 0; i < completers_.size(); ++i)
+		delete completers_[i];
+	completers_.clear();
+	range_keys_.clear();
+	range_values_.clear();
+	key_offsets_.clear();
+	positions_.clear();
+	fill_range_ids_.clear();
+	range_id_ = 0;
+	candidates_.clear();
+	key_buf_.clear();
+	key_ = NULL;
+	length_ = 0;
+	value_ = TrieBase::INVALID_VALUE;
+}
+
+// Subtrees are replaced with their roots and children level by level,
+// which keeps ranges in dictionary order.
+inline void ParallelCompleter::split(UInt32 index, UInt32 min_num_ranges)
+{
+	range_indices_.assign(1, index);
+	range_is_subtrees_.assign(1, true);
+	range_prefixes_.assign(1, std::string());
+
+	std::vector<UInt32> indices;
+	std::vector<bool> is_subtrees;
+	std::vector<std::string> prefixes;
+	while (range_indices_.size() < min_num_ranges)
+	{
+		bool is_split = false;
+		for (UInt32 range_id = 0; range_id < range_indices_.size(); ++range_id)
+		{
+			UInt32 range_index = range_indices_[range_id];
+			const std::string &prefix = range_prefixes_[range_id];
+			UInt32 child_index = range_is_subtrees_[range_id] ?
+				trie_->child(range_index) : 0;
+			if (child_index == 0)
+			{
+				indices.push_back(range_index);
+				is_subtrees.push_back(range_is_subtrees_[range_id]);
+				prefixes.push_back(prefix);
+				continue;
+			}
+
+			if (trie_->has_value(range_index))
+			{
+				indices.push_back(range_index);
+				is_subtrees.push_back(false);
+				prefixes.push_back(prefix);
+			}
+			for ( ; child_index != 0;
+				child_index = trie_->sibling(child_index))
+			{
+				indices.push_back(child_index);
+				is_subtrees.push_back(true);
+				prefixes.push_back(prefix +
+					static_cast<char>(trie_->label(child_index)));
+			}
+			is_split = true;
+		}
+
+		range_indices_.swap(indices);
+		range_is_subtrees_.swap(is_subtrees);
+		range_prefixes_.swap(prefixes);
+		indices.clear();
+		is_subtrees.clear();
+		prefixes.clear();
+
+		if (!is_split)
+			break;
+	}
+}
+
+// A buffer is refilled only after all of its keys are taken, and it keeps
+// no more keys than the remaining results.
+inline void ParallelCompleter::fill_range(UInt32 range_id)
+{
+	CompleterBase *completer = completers_[range_id];
+	if (completer == NULL)
+		return;
+
+	std::vector<char> &keys = range_keys_[range_id];
+	std::vector<UInt32> &values = range_values_[range_id];
+	keys.clear();
+	values.clear();
+	key_offsets_[range_id] = 0;
+	positions_[range_id] = 0;
+
+	UInt32 max_num_keys = std::min(buffer_size_,
+		max_num_results_ - num_results_);
+	while (values.size() < max_num_keys)
+	{
+		if (!completer->next())
+		{
+			delete completer;
+			completers_[range_id] = NULL;
+			break;
+		}
+		keys.insert(keys.end(), completer->key(),
+			completer->key() + completer->length() + 1);
+		values.push_back(completer->value());
+	}
+}
+
+// Ranges are taken by threads one by one, so that a thread which finishes
+// small ranges early takes the remaining ones.
+inline void ParallelCompleter::fill_ranges()
+{
+	int num_ranges_to_fill = static_cast<int>(fill_range_ids_.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif  // _OPENMP
+	for (int i = 0; i < num_ranges_to_fill; ++i)
+		fill_range(fill_range_ids_[i]);
+	fill_range_ids_.clear();
+}
+
+// A drained range is refilled together with the next ranges that need keys,
+// up to one range per thread, so that the ranges ahead of next() are filled
+// in parallel. The scan wraps around because drained ranges in VALUE_ORDER
+// may come before the given one.
+inline bool ParallelCompleter::has_key(UInt32 range_id)
+{
+	if (positions_[range_id] < range_values_[range_id].size())
+		return true;
+	if (completers_[range_id] == NULL)
+		return false;
+
+#ifdef _OPENMP
+	UInt32 max_num_ranges = static_cast<UInt32>(omp_get_max_threads());
+#else  // _OPENMP
+	UInt32 max_num_ranges = 1;
+#endif  // _OPENMP
+
+	fill_range_ids_.push_back(range_id);
+	for (UInt32 i = 1; i < num_ranges() &&
+		fill_range_ids_.size() < max_num_ranges; ++i)
+	{
+		UInt32 next_range_id = (range_id + i) % num_ranges();
+		if (completers_[next_range_id] != NULL &&
+			positions_[next_range_id] == range_values_[next_range_id].size())
+			fill_range_ids_.push_back(next_range_id);
+	}
+	fill_ranges();
+
+	return positions_[range_id] < range_values_[range_id].size();
+}
+
+// A drained range is not refilled here but keeps its last value, so that
+// drained ranges are refilled together when one of them is taken.
+inline void ParallelCompleter::push_candidate(UInt32 range_id)
+{
+	const std::vector<UInt32> &values = range_values_[range_id];
+	UInt32 position = positions_[range_id];
+	if (position == values.size() &&
+		(completers_[range_id] == NULL || values.empty()))
+		return;
+
+	ValueOrderCompleterCandidate candidate;
+	candidate.set_index(range_id);
+	candidate.set_value((position < values.size()) ?
+		values[position] : values.back());
+	candidates_.push_back(candidate);
+	std::push_heap(candidates_.begin(), candidates_.end());
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_PARALLEL_COMPLETER_IN_H
@@ -0,0 +1,107 @@
+#ifndef SUMIRE_PARALLEL_COMPLETER_H
+#define SUMIRE_PARALLEL_COMPLETER_H
+
+#include "completer-base.h"
+#include "value-order-completer-candidate.h"
+
+#include <string>
+#include <vector>
+
+namespace sumire {
+
+// ParallelCompleter splits the subtree of a start node into ranges of
+// subtrees in dictionary order, and enumerates the ranges in parallel if
+// OpenMP is enabled. Each range keeps its own completer and buffers up to
+// buffer_size keys without its prefix, and the ranges are concatenated in
+// DICTIONARY_ORDER or merged in VALUE_ORDER. A range whose buffer runs out
+// is refilled by its completer, together with other ranges that need keys,
+// so memory does not grow with the number of keys.
+class ParallelCompleter : public CompleterBase
+{
+public:
+	enum Order
+	{
+		// Siblings must be in ascending order of labels, as tries built
+		// with their default orders are.
+		DICTIONARY_ORDER,
+		// Siblings must be in MAX_VALUE_ORDER, as ValueOrderCompleter
+		// requires.
+		VALUE_ORDER
+	};
+
+	enum
+	{
+		DEFAULT_MIN_NUM_RANGES = 256,
+		DEFAULT_BUFFER_SIZE = 1024
+	};
+
+	ParallelCompleter() : trie_(NULL), order_(DICTIONARY_ORDER),
+		max_num_results_(0), buffer_size_(0), num_results_(0),
+		range_indices_(), range_is_subtrees_(), range_prefixes_(),
+		completers_(), range_keys_(), range_values_(), key_offsets_(),
+		positions_(), fill_range_ids_(), range_id_(0), candidates_(),
+		key_buf_(), key_(NULL), length_(0),
+		value_(TrieBase::INVALID_VALUE) {}
+	~ParallelCompleter() { clear(); }
+
+	bool start(const TrieBase &trie, UInt32 index);
+	// Splits the subtree into min_num_ranges or more ranges unless the
+	// subtree is too small, and buffers up to buffer_size keys per range.
+	bool start(const TrieBase &trie, UInt32 index, Order order,
+		UInt32 max_num_results = UInt32Limits::max(),
+		UInt32 min_num_ranges = DEFAULT_MIN_NUM_RANGES,
+		UInt32 buffer_size = DEFAULT_BUFFER_SIZE);
+	bool next();
+
+	const char *key() const { return key_; }
+	UInt32 length() const { return length_; }
+	UInt32 value() const { return value_; }
+
+	UInt32 num_ranges() const { return range_indices_.size(); }
+
+	void clear();
+
+private:
+	const TrieBase *trie_;
+	Order order_;
+	UInt32 max_num_results_;
+	UInt32 buffer_size_;
+	UInt32 num_results_;
+	// A range is either a whole subtree or only the key of its root.
+	std::vector<UInt32> range_indices_;
+	std::vector<bool> range_is_subtrees_;
+	std::vector<std::string> range_prefixes_;
+	// A completer is deleted when it finishes, and a range of a single key
+	// has no completer.
+	std::vector<CompleterBase *> completers_;
+	std::vector<std::vector<char> > range_keys_;
+	std::vector<std::vector<UInt32> > range_values_;
+	std::vector<UInt32> key_offsets_;
+	std::vector<UInt32> positions_;
+	std::vector<UInt32> fill_range_ids_;
+	UInt32 range_id_;
+	// The next keys of ranges are merged in VALUE_ORDER, and a candidate
+	// keeps a range ID as its index.
+	std::vector<ValueOrderCompleterCandidate> candidates_;
+	std::vector<char> key_buf_;
+	const char *key_;
+	UInt32 length_;
+	UInt32 value_;
+
+	// Disallows copies.
+	ParallelCompleter(const ParallelCompleter &);
+	ParallelCompleter &operator=(const ParallelCompleter &);
+
+	void split(UInt32 index, UInt32 min_num_ranges);
+	void fill_ranges();
+	void fill_range(UInt32 range_id);
+	bool has_key(UInt32 range_id);
+
+	void push_candidate(UInt32 range_id);
+};
+
+}  // namespace sumire
+
+#include "parallel-completer-in.h"
+
+#endif  // SUMIRE_PARALLEL_COMPLETER_H
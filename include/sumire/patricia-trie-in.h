@@ -0,0 +1,777 @@
+#ifndef SUMIRE_PATRICIA_TRIE_IN_H
+#define SUMIRE_PATRICIA_TRIE_IN_H
+
+#include "label-scanner.h"
+#include "object-io.h"
+#include "trie-builder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <queue>
+
+namespace sumire {
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(
+	const TrieBase &trie)
+{
+	return build(trie, 0);
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(
+	const TrieBase &trie, UInt32 num_nested_levels)
+{
+	if (trie.num_nodes() == 0)
+		return false;
+
+	BitVector louds_bv(BitVector::CONTIGUOUS_STORAGE);
+	BitVector has_value_bv(BitVector::CONTIGUOUS_STORAGE);
+	BitVector has_tail_bv(BitVector::CONTIGUOUS_STORAGE);
+	BitVector tail_bv(BitVector::CONTIGUOUS_STORAGE);
+	louds_bv.append_unary(1);
+
+	std::vector<UInt8> labels;
+	std::vector<UInt8> tails(1, '\0');
+	std::vector<UInt32> values;
+	tail_bv.add(true);
+
+	std::queue<UInt32> queue;
+	queue.push(trie.root());
+	while (!queue.empty())
+	{
+		UInt32 index = queue.front();
+		queue.pop();
+
+		labels.push_back(trie.label(index));
+
+		// A chain of nodes that have only one child and no value is merged
+		// into the tail of its first node. The root has no tail.
+		bool has_tail = false;
+		if (index != trie.root())
+		{
+			for (UInt32 child_index = trie.child(index);
+				child_index != 0 && trie.sibling(child_index) == 0 &&
+				!trie.get_value(index); child_index = trie.child(index))
+			{
+				tails.push_back(trie.label(child_index));
+				tail_bv.add(false);
+				has_tail = true;
+				index = child_index;
+			}
+		}
+		if (has_tail)
+		{
+			tails.push_back('\0');
+			tail_bv.add(true);
+		}
+		has_tail_bv.add(has_tail);
+
+		UInt32 value;
+		bool has_value = trie.get_value(index, &value);
+		if (has_value)
+			values.push_back(value);
+		has_value_bv.add(has_value);
+
+		UInt32 num_children = 0;
+		for (UInt32 child_index = trie.child(index); child_index != 0;
+			child_index = trie.sibling(child_index))
+		{
+			queue.push(child_index);
+			++num_children;
+		}
+		louds_bv.append_unary(num_children);
+	}
+
+	assert(louds_bv.num_bits() == (labels.size() * 2) + 1);
+	assert(values.size() == trie.num_keys());
+
+	PatriciaTrie nested_trie;
+	ObjectArray<UInt32> links;
+	if (num_nested_levels > 0 && tails.size() > 1)
+	{
+		if (!build_nested_trie(tails, num_nested_levels - 1,
+			&nested_trie, &links))
+			return false;
+		tails.clear();
+	}
+
+	SuccinctBitVector louds_sbv, has_value_sbv, has_tail_sbv, tail_sbv;
+	louds_sbv.build(&louds_bv);
+	has_value_sbv.build(&has_value_bv);
+	has_tail_sbv.build(&has_tail_bv);
+	tail_sbv.build(&tail_bv);
+
+	ObjectArray<UInt8> label_array, tail_array;
+	ObjectArray<UInt32> value_array;
+	label_array.resize(static_cast<UInt32>(labels.size()));
+	std::copy(labels.begin(), labels.end(), label_array.begin());
+	tail_array.resize(static_cast<UInt32>(tails.size()));
+	std::copy(tails.begin(), tails.end(), tail_array.begin());
+	value_array.resize(static_cast<UInt32>(values.size()));
+	std::copy(values.begin(), values.end(), value_array.begin());
+
+	clear();
+	louds_sbv_.swap(&louds_sbv);
+	has_value_sbv_.swap(&has_value_sbv);
+	has_tail_sbv_.swap(&has_tail_sbv);
+	tail_sbv_.swap(&tail_sbv);
+	labels_.swap(&label_array);
+	tails_.swap(&tail_array);
+	links_.swap(&links);
+	values_.swap(&value_array);
+	if (nested_trie.num_edges() != 0)
+	{
+		nested_trie_ = new PatriciaTrie;
+		nested_trie_->swap(&nested_trie);
+	}
+
+	return true;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::find(
+	const char *key, UInt32 *value_ptr) const
+{
+	assert(key != NULL);
+
+	return find(key, static_cast<UInt32>(std::strlen(key)), value_ptr);
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::find(
+	const char *key, UInt32 length, UInt32 *value_ptr) const
+{
+	assert(key != NULL || length == 0);
+
+	if (num_edges() == 0)
+		return false;
+
+	UInt32 index, node_id;
+	if (!follow_edges(root(), reinterpret_cast<const UInt8 *>(key),
+		length, &index, &node_id) || node_id == num_edges())
+		return false;
+
+	return get_node_value(node_id, value_ptr);
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::follow(UInt32 index,
+	const char *seq, UInt32 *index_ptr) const
+{
+	assert(seq != NULL);
+
+	return follow(index, seq, static_cast<UInt32>(std::strlen(seq)),
+		index_ptr);
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::follow(UInt32 index,
+	const char *seq, UInt32 length, UInt32 *index_ptr) const
+{
+	assert(index < num_units());
+	assert(seq != NULL || length == 0);
+
+	UInt32 node_id;
+	if (!follow_edges(index, reinterpret_cast<const UInt8 *>(seq),
+		length, &index, &node_id))
+		return false;
+
+	if (index_ptr != NULL)
+		*index_ptr = index;
+	return true;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::find_child(
+	UInt32 index, UInt8 child_label) const
+{
+	assert(index < num_units());
+
+	UInt32 node_index = index;
+	if (index >= louds_sbv_.num_bits())
+	{
+		UInt32 tail_pos = index - louds_sbv_.num_bits() + 1;
+		if (!tail_sbv_[tail_pos])
+			return (tail_label(tail_pos) == child_label) ? (index + 1) : 0;
+
+		node_index = louds_sbv_.select_1(tail_node_id(tail_pos - 1) + 1);
+	}
+	else
+	{
+		UInt32 tail_pos = tail_begin(louds_sbv_.rank_1(index) - 1);
+		if (tail_pos != 0)
+		{
+			return (tail_label(tail_pos) == child_label) ?
+				(louds_sbv_.num_bits() + tail_pos) : 0;
+		}
+	}
+
+	UInt32 node_id;
+	return find_node_child(node_index, child_label, &node_id);
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::child(
+	UInt32 index) const
+{
+	assert(index < num_units());
+
+	UInt32 node_index = index;
+	if (index >= louds_sbv_.num_bits())
+	{
+		UInt32 tail_pos = index - louds_sbv_.num_bits() + 1;
+		if (!tail_sbv_[tail_pos])
+			return index + 1;
+
+		node_index = louds_sbv_.select_1(tail_node_id(tail_pos - 1) + 1);
+	}
+	else
+	{
+		UInt32 tail_pos = tail_begin(louds_sbv_.rank_1(index) - 1);
+		if (tail_pos != 0)
+			return louds_sbv_.num_bits() + tail_pos;
+	}
+	return node_child(node_index);
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::sibling(
+	UInt32 index) const
+{
+	assert(index < num_units());
+
+	if (index >= louds_sbv_.num_bits())
+		return 0;
+
+	return louds_sbv_[index + 1] ? (index + 1) : 0;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt8 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::label(
+	UInt32 index) const
+{
+	assert(index < num_units());
+
+	if (index >= louds_sbv_.num_bits())
+		return tail_label(index - louds_sbv_.num_bits());
+
+	return labels_[louds_sbv_.rank_1(index) - 1];
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::get_value(
+	UInt32 index, UInt32 *value_ptr) const
+{
+	assert(index < num_units());
+
+	UInt32 node_id;
+	if (index >= louds_sbv_.num_bits())
+	{
+		UInt32 tail_pos = index - louds_sbv_.num_bits() + 1;
+		if (!tail_sbv_[tail_pos])
+			return false;
+
+		node_id = tail_node_id(tail_pos - 1);
+	}
+	else
+	{
+		node_id = louds_sbv_.rank_1(index) - 1;
+		if (tail_begin(node_id) != 0)
+			return false;
+	}
+	return get_node_value(node_id, value_ptr);
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::num_units() const
+{
+	return louds_sbv_.num_bits() + tail_sbv_.num_bits();
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::num_nodes() const
+{
+	// Each label in tails is a node, and tail_sbv_ marks '\0's with 1s.
+	return num_edges() + tail_sbv_.num_zeros();
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::num_tails() const
+{
+	return (tail_sbv_.num_ones() != 0) ? (tail_sbv_.num_ones() - 1) : 0;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::num_nested_levels()
+	const
+{
+	return (nested_trie_ != NULL) ? (nested_trie_->num_nested_levels() + 1)
+		: 0;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::size() const
+{
+	UInt32 size = louds_sbv_.size() + has_value_sbv_.size()
+		+ has_tail_sbv_.size() + tail_sbv_.size() + labels_.size()
+		+ tails_.size() + links_.size() + values_.size();
+	if (nested_trie_ != NULL)
+		size += nested_trie_->size();
+	return size;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline void PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::clear()
+{
+	louds_sbv_.clear();
+	has_value_sbv_.clear();
+	has_tail_sbv_.clear();
+	tail_sbv_.clear();
+	labels_.clear();
+	tails_.clear();
+	links_.clear();
+	values_.clear();
+
+	delete nested_trie_;
+	nested_trie_ = NULL;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline void *PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::map(void *addr)
+{
+	assert(addr != NULL);
+
+	clear();
+
+	addr = louds_sbv_.map(addr);
+	addr = has_value_sbv_.map(addr);
+	addr = has_tail_sbv_.map(addr);
+	addr = tail_sbv_.map(addr);
+	addr = labels_.map(addr);
+	addr = tails_.map(addr);
+	addr = links_.map(addr);
+	addr = values_.map(addr);
+
+	ObjectClipper clipper(addr);
+	UInt32 has_nested_trie = *clipper.clip<UInt32>();
+	addr = clipper.addr();
+
+	if (has_nested_trie != 0)
+	{
+		nested_trie_ = new PatriciaTrie;
+		addr = nested_trie_->map(addr);
+	}
+
+	return addr;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::read(
+	std::istream *input)
+{
+	assert(input != NULL);
+
+	SuccinctBitVector louds_sbv, has_value_sbv, has_tail_sbv, tail_sbv;
+	if (!louds_sbv.read(input) || !has_value_sbv.read(input))
+		return false;
+	if (!has_tail_sbv.read(input) || !tail_sbv.read(input))
+		return false;
+
+	ObjectArray<UInt8> labels, tails;
+	if (!labels.read(input) || !tails.read(input))
+		return false;
+
+	ObjectArray<UInt32> links, values;
+	if (!links.read(input) || !values.read(input))
+		return false;
+
+	ObjectReader reader(input);
+
+	UInt32 has_nested_trie;
+	if (!reader.read(&has_nested_trie))
+		return false;
+
+	PatriciaTrie nested_trie;
+	if (has_nested_trie != 0 && !nested_trie.read(input))
+		return false;
+
+	clear();
+	louds_sbv_.swap(&louds_sbv);
+	has_value_sbv_.swap(&has_value_sbv);
+	has_tail_sbv_.swap(&has_tail_sbv);
+	tail_sbv_.swap(&tail_sbv);
+	labels_.swap(&labels);
+	tails_.swap(&tails);
+	links_.swap(&links);
+	values_.swap(&values);
+	if (has_nested_trie != 0)
+	{
+		nested_trie_ = new PatriciaTrie;
+		nested_trie_->swap(&nested_trie);
+	}
+
+	return true;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::write(
+	std::ostream *output) const
+{
+	assert(output != NULL);
+
+	if (!louds_sbv_.write(output) || !has_value_sbv_.write(output))
+		return false;
+	if (!has_tail_sbv_.write(output) || !tail_sbv_.write(output))
+		return false;
+
+	if (!labels_.write(output) || !tails_.write(output))
+		return false;
+
+	if (!links_.write(output) || !values_.write(output))
+		return false;
+
+	ObjectWriter writer(output);
+
+	UInt32 has_nested_trie = (nested_trie_ != NULL) ? 1 : 0;
+	if (!writer.write(has_nested_trie))
+		return false;
+
+	if (nested_trie_ != NULL && !nested_trie_->write(output))
+		return false;
+
+	return true;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline void PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::swap(
+	PatriciaTrie *target)
+{
+	assert(target != NULL);
+
+	louds_sbv_.swap(&target->louds_sbv_);
+	has_value_sbv_.swap(&target->has_value_sbv_);
+	has_tail_sbv_.swap(&target->has_tail_sbv_);
+	tail_sbv_.swap(&target->tail_sbv_);
+	labels_.swap(&target->labels_);
+	tails_.swap(&target->tails_);
+	links_.swap(&target->links_);
+	values_.swap(&target->values_);
+	std::swap(nested_trie_, target->nested_trie_);
+}
+
+// Tails are reversed before insertion so that walking up from the node of
+// a tail restores the tail in order.
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::build_nested_trie(
+	const std::vector<UInt8> &tails, UInt32 num_nested_levels,
+	PatriciaTrie *nested_trie, ObjectArray<UInt32> *links)
+{
+	assert(nested_trie != NULL);
+	assert(links != NULL);
+
+	std::vector<std::string> keys;
+	for (std::size_t begin = 1; begin < tails.size(); )
+	{
+		std::size_t end = begin;
+		while (tails[end] != '\0')
+			++end;
+
+		keys.push_back(std::string(tails.begin() + begin,
+			tails.begin() + end));
+		std::reverse(keys.back().begin(), keys.back().end());
+		begin = end + 1;
+	}
+
+	std::vector<std::string> sorted_keys(keys);
+	std::sort(sorted_keys.begin(), sorted_keys.end());
+	sorted_keys.erase(std::unique(sorted_keys.begin(), sorted_keys.end()),
+		sorted_keys.end());
+
+	TrieBuilder builder;
+	for (std::size_t i = 0; i < sorted_keys.size(); ++i)
+	{
+		if (!builder.insert(sorted_keys[i].c_str(),
+			static_cast<UInt32>(sorted_keys[i].length()), 0))
+			return false;
+	}
+	if (!builder.finish())
+		return false;
+
+	if (!nested_trie->build(builder.virtual_trie(), num_nested_levels))
+		return false;
+
+	// Every key has a value, and thus it ends at the end of an edge.
+	ObjectArray<UInt32> node_ids;
+	node_ids.resize(static_cast<UInt32>(keys.size()));
+	for (std::size_t i = 0; i < keys.size(); ++i)
+	{
+		UInt32 index;
+		if (!nested_trie->follow_edges(nested_trie->root(),
+			reinterpret_cast<const UInt8 *>(keys[i].data()),
+			static_cast<UInt32>(keys[i].length()), &index, &node_ids[i]))
+			return false;
+		assert(node_ids[i] < nested_trie->num_edges());
+	}
+
+	node_ids.swap(links);
+	return true;
+}
+
+// This function follows a sequence edge by edge, and each tail is compared
+// with memcmp(). If the sequence ends at the end of an edge, *node_id_ptr
+// gets the node ID of the edge, otherwise it gets num_edges().
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::follow_edges(
+	UInt32 index, const UInt8 *seq, UInt32 length,
+	UInt32 *index_ptr, UInt32 *node_id_ptr) const
+{
+	const UInt32 num_louds_bits = louds_sbv_.num_bits();
+
+	UInt32 node_index, node_id, tail_pos;
+	if (index < num_louds_bits)
+	{
+		node_index = index;
+		node_id = louds_sbv_.rank_1(index) - 1;
+		tail_pos = tail_begin(node_id);
+	}
+	else
+	{
+		// The node of a tail is looked up only when the tail is passed.
+		tail_pos = index - num_louds_bits + 1;
+		node_index = num_louds_bits;
+		node_id = num_edges();
+		if (tail_sbv_[tail_pos])
+		{
+			node_id = tail_node_id(tail_pos - 1);
+			node_index = louds_sbv_.select_1(node_id + 1);
+		}
+	}
+
+	std::string buf;
+	UInt32 i = 0;
+	for ( ; ; )
+	{
+		if (!tail_sbv_[tail_pos])
+		{
+			UInt32 tail_length;
+			const UInt8 *tail = find_tail(tail_pos, &buf, &tail_length);
+			if (tail_length > length - i)
+			{
+				// The sequence ends inside the tail.
+				if (std::memcmp(tail, seq + i, length - i) != 0)
+					return false;
+				if (i < length)
+					index = num_louds_bits + tail_pos + (length - i) - 1;
+				node_id = num_edges();
+				break;
+			}
+			if (std::memcmp(tail, seq + i, tail_length) != 0)
+				return false;
+
+			i += tail_length;
+			index = num_louds_bits + tail_pos + tail_length - 1;
+			if (node_index == num_louds_bits)
+			{
+				node_id = tail_node_id(tail_pos);
+				node_index = louds_sbv_.select_1(node_id + 1);
+			}
+		}
+
+		if (i == length)
+			break;
+
+		node_index = find_node_child(node_index, seq[i++], &node_id);
+		if (node_index == 0)
+			return false;
+		index = node_index;
+		tail_pos = tail_begin(node_id);
+	}
+
+	*index_ptr = index;
+	*node_id_ptr = node_id;
+	return true;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::find_node_child(
+	UInt32 node_index, UInt8 child_label, UInt32 *node_id_ptr) const
+{
+	assert(node_index < louds_sbv_.num_bits());
+
+	UInt32 child_count = louds_sbv_.rank_1(node_index);
+	UInt32 child_index = louds_sbv_.select_0(child_count) + 1;
+	UInt32 num_children = louds_sbv_.run_length_1(child_index);
+	if (num_children == 0)
+		return 0;
+
+	UInt32 node_id = child_index - child_count;
+	UInt32 offset = LabelScanner::find(&labels_[node_id],
+		num_children, child_label);
+	if (offset == num_children)
+		return 0;
+
+	*node_id_ptr = node_id + offset;
+	return child_index + offset;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::node_child(
+	UInt32 node_index) const
+{
+	assert(node_index < louds_sbv_.num_bits());
+
+	UInt32 child_index =
+		louds_sbv_.select_0(louds_sbv_.rank_1(node_index)) + 1;
+	return louds_sbv_[child_index] ? child_index : 0;
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline bool PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::get_node_value(
+	UInt32 node_id, UInt32 *value_ptr) const
+{
+	assert(node_id < num_edges());
+
+	if (!has_value_sbv_[node_id])
+		return false;
+
+	if (value_ptr != NULL)
+	{
+		UInt32 value_id = has_value_sbv_.rank_1(node_id) - 1;
+		assert(value_id < num_keys());
+
+		*value_ptr = values_[value_id];
+	}
+	return true;
+}
+
+// The children of a node follow the rank_1(node)-th 0 in louds_sbv_, and
+// thus a node follows the rank_0(node)-th 1, which is its parent.
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::parent_node_id(
+	UInt32 node_id) const
+{
+	assert(node_id > 0);
+	assert(node_id < num_edges());
+
+	return louds_sbv_.select_1(node_id + 1) - node_id - 1;
+}
+
+// Returns the position of the first label of a tail, or 0 if the node has
+// no tail.
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::tail_begin(
+	UInt32 node_id) const
+{
+	assert(node_id < num_edges());
+
+	if (!has_tail_sbv_[node_id])
+		return 0;
+
+	return tail_sbv_.select_1(has_tail_sbv_.rank_1(node_id)) + 1;
+}
+
+// Returns the node ID of the edge that has a label at tail_pos.
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt32 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::tail_node_id(
+	UInt32 tail_pos) const
+{
+	assert(tail_pos > 0);
+	assert(tail_pos < tail_sbv_.num_bits());
+
+	return has_tail_sbv_.select_1(tail_sbv_.rank_1(tail_pos));
+}
+
+// A nested tail is restored only up to the label, so reading a tail label
+// by label costs more as the offset grows, but the trie is not modified.
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline UInt8 PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::tail_label(
+	UInt32 tail_pos) const
+{
+	assert(tail_pos < tail_sbv_.num_bits());
+
+	if (nested_trie_ == NULL)
+		return tails_[tail_pos];
+
+	UInt32 tail_id = tail_sbv_.rank_1(tail_pos) - 1;
+	UInt32 offset = tail_pos - (tail_sbv_.select_1(tail_id + 1) + 1);
+
+	std::string tail;
+	nested_trie_->restore(links_[tail_id], &tail, offset + 1);
+	assert(offset < tail.length());
+
+	return static_cast<UInt8>(tail[offset]);
+}
+
+// Appends the labels from a node to the root, that is, a key in reverse,
+// and stops at the first node that makes the key min_length or longer.
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline void PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::restore(
+	UInt32 node_id, std::string *key, UInt32 min_length) const
+{
+	assert(node_id < num_edges());
+	assert(key != NULL);
+
+	for ( ; node_id != 0 && key->length() < min_length;
+		node_id = parent_node_id(node_id))
+	{
+		if (has_tail_sbv_[node_id])
+		{
+			std::size_t begin = key->length();
+			restore_tail(has_tail_sbv_.rank_1(node_id) - 1, key);
+			std::reverse(key->begin() + begin, key->end());
+		}
+		key->push_back(static_cast<char>(labels_[node_id]));
+	}
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline void PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::restore_tail(
+	UInt32 tail_id, std::string *tail) const
+{
+	assert(tail_id < num_tails());
+	assert(tail != NULL);
+
+	if (nested_trie_ != NULL)
+		nested_trie_->restore(links_[tail_id], tail);
+	else
+	{
+		const UInt8 *labels = &tails_[tail_sbv_.select_1(tail_id + 1) + 1];
+		tail->append(reinterpret_cast<const char *>(labels));
+	}
+}
+
+// Returns the labels from tail_pos to the end of its tail. A nested tail is
+// restored into buf.
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+inline const UInt8 *PatriciaTrie<SUCCINCT_BIT_VECTOR_TYPE>::find_tail(
+	UInt32 tail_pos, std::string *buf, UInt32 *length_ptr) const
+{
+	assert(tail_pos < tail_sbv_.num_bits());
+	assert(!tail_sbv_[tail_pos]);
+	assert(buf != NULL);
+	assert(length_ptr != NULL);
+
+	if (nested_trie_ == NULL)
+	{
+		const UInt8 *tail = &tails_[tail_pos];
+		*length_ptr = static_cast<UInt32>(
+			std::strlen(reinterpret_cast<const char *>(tail)));
+		return tail;
+	}
+
+	UInt32 tail_id = tail_sbv_.rank_1(tail_pos) - 1;
+	UInt32 offset = tail_pos - (tail_sbv_.select_1(tail_id + 1) + 1);
+
+	buf->clear();
+	restore_tail(tail_id, buf);
+	assert(offset < buf->length());
+
+	*length_ptr = static_cast<UInt32>(buf->length()) - offset;
+	return reinterpret_cast<const UInt8 *>(buf->data()) + offset;
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_PATRICIA_TRIE_IN_H
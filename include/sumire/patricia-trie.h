@@ -0,0 +1,118 @@
+#ifndef SUMIRE_PATRICIA_TRIE_H
+#define SUMIRE_PATRICIA_TRIE_H
+
+#include "basic-succinct-bit-vector.h"
+#include "object-array.h"
+#include "trie-base.h"
+
+#include <string>
+#include <vector>
+
+namespace sumire {
+
+// PatriciaTrie is a LOUDS trie whose unary chains are compressed into
+// edges. The first label of each edge is stored in labels_, and the rest
+// of the edge, which is called a tail, is stored in tails_ with a '\0'.
+// tails_ starts with a '\0', and tail_sbv_ marks the positions of '\0's.
+//
+// If nested levels are given to build(), tails are reversed and stored as
+// keys of a nested PatriciaTrie instead, and links_ keeps the node ID of
+// each tail in the nested trie. Walking up from the node restores a tail.
+// Tails of the nested trie are nested again until the levels run out.
+//
+// Indices less than the number of LOUDS bits are positions in louds_sbv_,
+// and each of them represents the state after the first label of an edge.
+// The other indices represent states inside tails, and each of them is
+// the number of LOUDS bits plus the position of the last label in tails_.
+// With nested tails, positions are those in tails_ without nesting.
+template <typename SUCCINCT_BIT_VECTOR_TYPE = BasicSuccinctBitVector>
+class PatriciaTrie : public TrieBase
+{
+public:
+	typedef SUCCINCT_BIT_VECTOR_TYPE SuccinctBitVector;
+
+	PatriciaTrie() : louds_sbv_(), has_value_sbv_(), has_tail_sbv_(),
+		tail_sbv_(), labels_(), tails_(), links_(), values_(),
+		nested_trie_(NULL) {}
+	~PatriciaTrie() { clear(); }
+
+	bool build(const TrieBase &trie);
+	bool build(const TrieBase &trie, UInt32 num_nested_levels);
+
+	// These functions compare whole tails instead of following labels one
+	// by one, and they hide the functions of TrieBase.
+	bool find(const char *key, UInt32 *value_ptr = NULL) const;
+	bool find(const char *key, UInt32 length, UInt32 *value_ptr = NULL) const;
+
+	bool follow(UInt32 index, const char *seq, UInt32 *index_ptr) const;
+	bool follow(UInt32 index, const char *seq, UInt32 length,
+		UInt32 *index_ptr) const;
+
+	UInt32 find_child(UInt32 index, UInt8 child_label) const;
+
+	UInt32 child(UInt32 index) const;
+	UInt32 sibling(UInt32 index) const;
+	UInt8 label(UInt32 index) const;
+
+	bool get_value(UInt32 index, UInt32 *value_ptr = NULL) const;
+
+	UInt32 num_units() const;
+	UInt32 num_nodes() const;
+	UInt32 num_edges() const { return labels_.num_objs(); }
+	UInt32 num_tails() const;
+	UInt32 num_nested_levels() const;
+	UInt32 num_keys() const { return values_.num_objs(); }
+	UInt32 size() const;
+
+	void clear();
+	void *map(void *addr);
+	bool read(std::istream *input);
+	bool write(std::ostream *output) const;
+
+	void swap(PatriciaTrie *target);
+
+private:
+	SuccinctBitVector louds_sbv_;
+	SuccinctBitVector has_value_sbv_;
+	SuccinctBitVector has_tail_sbv_;
+	SuccinctBitVector tail_sbv_;
+	ObjectArray<UInt8> labels_;
+	ObjectArray<UInt8> tails_;
+	ObjectArray<UInt32> links_;
+	ObjectArray<UInt32> values_;
+	PatriciaTrie *nested_trie_;
+
+	// Disallows copies.
+	PatriciaTrie(const PatriciaTrie &);
+	PatriciaTrie &operator=(const PatriciaTrie &);
+
+	static bool build_nested_trie(const std::vector<UInt8> &tails,
+		UInt32 num_nested_levels, PatriciaTrie *nested_trie,
+		ObjectArray<UInt32> *links);
+
+	bool follow_edges(UInt32 index, const UInt8 *seq, UInt32 length,
+		UInt32 *index_ptr, UInt32 *node_id_ptr) const;
+
+	UInt32 find_node_child(UInt32 node_index, UInt8 child_label,
+		UInt32 *node_id_ptr) const;
+	UInt32 node_child(UInt32 node_index) const;
+	bool get_node_value(UInt32 node_id, UInt32 *value_ptr) const;
+
+	UInt32 parent_node_id(UInt32 node_id) const;
+
+	UInt32 tail_begin(UInt32 node_id) const;
+	UInt32 tail_node_id(UInt32 tail_pos) const;
+	UInt8 tail_label(UInt32 tail_pos) const;
+
+	void restore(UInt32 node_id, std::string *key,
+		UInt32 min_length = UInt32Limits::max()) const;
+	void restore_tail(UInt32 tail_id, std::string *tail) const;
+	const UInt8 *find_tail(UInt32 tail_pos, std::string *buf,
+		UInt32 *length_ptr) const;
+};
+
+}  // namespace sumire
+
+#include "patricia-trie-in.h"
+
+#endif  // SUMIRE_PATRICIA_TRIE_H
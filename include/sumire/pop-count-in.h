@@ -0,0 +1,67 @@
+#ifndef SUMIRE_POP_COUNT_IN_H
+#define SUMIRE_POP_COUNT_IN_H
+
+#include <cassert>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif  // __SSSE3__
+
+namespace sumire {
+
+inline UInt32 PopCount::count(UInt32 unit)
+{
+#ifdef __GNUC__
+	return __builtin_popcount(unit);
+#else  // __GNUC__
+	unit = ((unit & 0xAAAAAAAA) >> 1) + (unit & 0x55555555);
+	unit = ((unit & 0xCCCCCCCC) >> 2) + (unit & 0x33333333);
+	unit = ((unit >> 4) + unit) & 0x0F0F0F0F;
+	return (unit * 0x01010101) >> 24;
+#endif  // __GNUC__
+}
+
+inline void PopCount::count_units(const UInt32 *units, UInt32 num_units,
+	UInt8 *counts)
+{
+	assert(units != NULL || num_units == 0);
+	assert(counts != NULL || num_units == 0);
+
+	UInt32 unit_id = 0;
+
+#ifdef __SSSE3__
+	// Counts 1s in 4 units at once: nibble lookups with PSHUFB, and then
+	// horizontal additions of the byte counts into 32-bit lanes.
+	const __m128i table = _mm_setr_epi8(
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m128i low_mask = _mm_set1_epi8(0x0F);
+	const __m128i ones_8 = _mm_set1_epi8(1);
+	const __m128i ones_16 = _mm_set1_epi16(1);
+
+	for ( ; unit_id + 4 <= num_units; unit_id += 4)
+	{
+		__m128i bits = _mm_loadu_si128(
+			reinterpret_cast<const __m128i *>(units + unit_id));
+		__m128i low = _mm_and_si128(bits, low_mask);
+		__m128i high = _mm_and_si128(_mm_srli_epi16(bits, 4), low_mask);
+		__m128i bytes = _mm_add_epi8(_mm_shuffle_epi8(table, low),
+			_mm_shuffle_epi8(table, high));
+		__m128i words = _mm_madd_epi16(
+			_mm_maddubs_epi16(bytes, ones_8), ones_16);
+		words = _mm_packus_epi16(_mm_packs_epi32(words, words), words);
+
+		UInt32 packed = static_cast<UInt32>(_mm_cvtsi128_si32(words));
+		counts[unit_id] = static_cast<UInt8>(packed);
+		counts[unit_id + 1] = static_cast<UInt8>(packed >> 8);
+		counts[unit_id + 2] = static_cast<UInt8>(packed >> 16);
+		counts[unit_id + 3] = static_cast<UInt8>(packed >> 24);
+	}
+#endif  // __SSSE3__
+
+	for ( ; unit_id < num_units; ++unit_id)
+		counts[unit_id] = static_cast<UInt8>(count(units[unit_id]));
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_POP_COUNT_IN_H
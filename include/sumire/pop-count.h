@@ -0,0 +1,31 @@
+#ifndef SUMIRE_POP_COUNT_H
+#define SUMIRE_POP_COUNT_H
+
+#include "int-types.h"
+
+namespace sumire {
+
+class PopCount
+{
+public:
+	static UInt32 count(UInt32 unit);
+
+	// Stores the number of 1s in units[i] into counts[i].
+	static void count_units(const UInt32 *units, UInt32 num_units,
+		UInt8 *counts);
+
+private:
+	// Disallows instantiation.
+	PopCount() {}
+	~PopCount() {}
+
+	// Disallows copies.
+	PopCount(const PopCount &);
+	PopCount &operator=(const PopCount &);
+};
+
+}  // namespace sumire
+
+#include "pop-count-in.h"
+
+#endif  // SUMIRE_POP_COUNT_H
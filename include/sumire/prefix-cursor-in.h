@@ -0,0 +1,124 @@
+#ifndef SUMIRE_PREFIX_CURSOR_IN_H
+#define SUMIRE_PREFIX_CURSOR_IN_H
+
+#include <cassert>
+
+namespace sumire {
+
+inline bool PrefixCursor::start(const TrieBase &trie, UInt32 index)
+{
+	if (trie.num_units() == 0)
+		return false;
+
+	assert(index < trie.num_units());
+
+	clear();
+
+	trie_ = &trie;
+	indices_.push_back(index);
+	key_.push_back('\0');
+
+	return true;
+}
+
+inline bool PrefixCursor::push(char label)
+{
+	assert(trie_ != NULL);
+
+	key_.back() = label;
+	key_.push_back('\0');
+
+	if (num_misses_ == 0)
+	{
+		UInt32 child_index = trie_->find_child(indices_.back(), label);
+		if (child_index != 0)
+		{
+			indices_.push_back(child_index);
+			return true;
+		}
+	}
+	++num_misses_;
+	return false;
+}
+
+inline bool PrefixCursor::pop()
+{
+	assert(trie_ != NULL);
+
+	if (length() == 0)
+		return false;
+
+	key_.pop_back();
+	key_.back() = '\0';
+
+	if (num_misses_ != 0)
+		--num_misses_;
+	else
+		indices_.pop_back();
+	return true;
+}
+
+inline bool PrefixCursor::set_key(const char *key)
+{
+	assert(trie_ != NULL);
+	assert(key != NULL);
+
+	UInt32 common_length = 0;
+	while (common_length < length() && key[common_length] != '\0' &&
+		key[common_length] == key_[common_length])
+		++common_length;
+
+	while (length() > common_length)
+		pop();
+	for (key += common_length; *key != '\0'; ++key)
+		push(*key);
+
+	return is_found();
+}
+
+inline UInt32 PrefixCursor::index() const
+{
+	assert(is_found());
+
+	return indices_.back();
+}
+
+inline bool PrefixCursor::get_value(UInt32 *value_ptr) const
+{
+	assert(trie_ != NULL);
+
+	if (!is_found())
+		return false;
+
+	return trie_->get_value(indices_.back(), value_ptr);
+}
+
+inline const char *PrefixCursor::key() const
+{
+	assert(key_.size() > 0);
+
+	return &key_[0];
+}
+
+inline bool PrefixCursor::complete(CompleterBase *completer) const
+{
+	assert(trie_ != NULL);
+	assert(completer != NULL);
+
+	if (!is_found())
+		return false;
+
+	return completer->start(*trie_, indices_.back());
+}
+
+inline void PrefixCursor::clear()
+{
+	trie_ = NULL;
+	indices_.clear();
+	key_.clear();
+	num_misses_ = 0;
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_PREFIX_CURSOR_IN_H
@@ -0,0 +1,60 @@
+#ifndef SUMIRE_PREFIX_CURSOR_H
+#define SUMIRE_PREFIX_CURSOR_H
+
+#include "completer-base.h"
+#include "trie-base.h"
+
+#include <vector>
+
+namespace sumire {
+
+// PrefixCursor keeps the nodes on the path of a prefix, so that a label is
+// appended with a find_child() call and removed without any call. Indices
+// of nodes are the results of rank/select operations in succinct tries, and
+// the cursor reuses them during a typing session.
+class PrefixCursor
+{
+public:
+	PrefixCursor() : trie_(NULL), indices_(), key_(), num_misses_(0) {}
+	~PrefixCursor() { clear(); }
+
+	bool start(const TrieBase &trie, UInt32 index);
+
+	// Appends a label to the prefix, and returns whether the prefix is still
+	// in the trie. Labels after a mismatch are kept, so that pop() goes back
+	// to the right node.
+	bool push(char label);
+	// Removes the last label of the prefix, and fails if it is empty.
+	bool pop();
+	// Moves to another prefix, keeping the nodes of the common prefix.
+	bool set_key(const char *key);
+
+	bool is_found() const { return num_misses_ == 0; }
+	UInt32 index() const;
+	bool get_value(UInt32 *value_ptr = NULL) const;
+
+	const char *key() const;
+	UInt32 length() const { return key_.size() - 1; }
+
+	// Starts a completer from the current node, and fails if the prefix is
+	// not in the trie. Results are suffixes of the prefix.
+	bool complete(CompleterBase *completer) const;
+
+	void clear();
+
+private:
+	const TrieBase *trie_;
+	std::vector<UInt32> indices_;
+	std::vector<char> key_;
+	UInt32 num_misses_;
+
+	// Disallows copies.
+	PrefixCursor(const PrefixCursor &);
+	PrefixCursor &operator=(const PrefixCursor &);
+};
+
+}  // namespace sumire
+
+#include "prefix-cursor-in.h"
+
+#endif  // SUMIRE_PREFIX_CURSOR_H
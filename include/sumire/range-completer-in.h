@@ -0,0 +1,166 @@
+#ifndef SUMIRE_RANGE_COMPLETER_IN_H
+#define SUMIRE_RANGE_COMPLETER_IN_H
+
+#include <cassert>
+#include <cstring>
+
+namespace sumire {
+
+inline bool RangeCompleter::start(const TrieBase &trie, UInt32 index)
+{
+	if (trie.num_units() == 0)
+		return false;
+
+	assert(index < trie.num_units());
+
+	clear();
+
+	trie_ = &trie;
+	start_index_ = index;
+	indices_.push_back(index);
+	key_.push_back('\0');
+	step_ = VISIT_STEP;
+
+	return true;
+}
+
+// Follows lower_bound from the start node. If a node has no child with the
+// next label, the first key is in the subtree of the next greater child,
+// or after the subtree of the node.
+inline void RangeCompleter::seek(const char *lower_bound)
+{
+	assert(trie_ != NULL);
+	assert(lower_bound != NULL);
+
+	indices_.assign(1, start_index_);
+	key_.assign(1, '\0');
+
+	for ( ; *lower_bound != '\0'; ++lower_bound)
+	{
+		UInt8 label = static_cast<UInt8>(*lower_bound);
+
+		UInt32 child_index = trie_->child(indices_.back());
+		while (child_index != 0 && trie_->label(child_index) < label)
+			child_index = trie_->sibling(child_index);
+
+		if (child_index == 0)
+		{
+			step_ = SKIP_STEP;
+			return;
+		}
+
+		push_node(child_index);
+		if (trie_->label(child_index) != label)
+			break;
+	}
+	step_ = VISIT_STEP;
+}
+
+inline void RangeCompleter::set_upper_bound(const char *upper_bound)
+{
+	upper_bound_.clear();
+	if (upper_bound != NULL)
+	{
+		upper_bound_.assign(upper_bound,
+			upper_bound + std::strlen(upper_bound) + 1);
+	}
+}
+
+inline bool RangeCompleter::next()
+{
+	assert(trie_ != NULL);
+
+	if (indices_.empty())
+		return false;
+
+	if (step_ != VISIT_STEP && !find_next(step_ == DESCEND_STEP))
+		return false;
+
+	for ( ; ; )
+	{
+		if (trie_->get_value(indices_.back(), &value_))
+		{
+			if (!is_below_upper_bound())
+			{
+				indices_.clear();
+				return false;
+			}
+			step_ = DESCEND_STEP;
+			return true;
+		}
+
+		if (!find_next(true))
+			return false;
+	}
+}
+
+inline const char *RangeCompleter::key() const
+{
+	assert(key_.size() > 0);
+
+	return reinterpret_cast<const char *>(&key_[0]);
+}
+
+inline void RangeCompleter::clear()
+{
+	trie_ = NULL;
+	start_index_ = 0;
+	indices_.clear();
+	key_.clear();
+	upper_bound_.clear();
+	value_ = TrieBase::INVALID_VALUE;
+	step_ = VISIT_STEP;
+}
+
+// Moves to the next node in preorder, which is the next node in dictionary
+// order. The siblings of the start node are never visited.
+inline bool RangeCompleter::find_next(bool descends)
+{
+	assert(!indices_.empty());
+
+	UInt32 index = descends ? trie_->child(indices_.back()) : 0;
+	while (index == 0)
+	{
+		if (indices_.size() == 1)
+		{
+			indices_.clear();
+			return false;
+		}
+
+		index = trie_->sibling(indices_.back());
+		pop_node();
+	}
+	push_node(index);
+
+	return true;
+}
+
+// Keys are compared as sequences of unsigned bytes, as std::strcmp() does.
+inline bool RangeCompleter::is_below_upper_bound() const
+{
+	if (upper_bound_.empty())
+		return true;
+
+	return std::strcmp(key(),
+		reinterpret_cast<const char *>(&upper_bound_[0])) < 0;
+}
+
+inline void RangeCompleter::push_node(UInt32 index)
+{
+	indices_.push_back(index);
+	key_.back() = trie_->label(index);
+	key_.push_back('\0');
+}
+
+inline void RangeCompleter::pop_node()
+{
+	assert(indices_.size() > 1);
+
+	indices_.pop_back();
+	key_.pop_back();
+	key_.back() = '\0';
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_RANGE_COMPLETER_IN_H
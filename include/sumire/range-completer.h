@@ -0,0 +1,68 @@
+#ifndef SUMIRE_RANGE_COMPLETER_H
+#define SUMIRE_RANGE_COMPLETER_H
+
+#include "completer-base.h"
+
+#include <vector>
+
+namespace sumire {
+
+// RangeCompleter enumerates keys in dictionary order from a lower bound to
+// an exclusive upper bound. Siblings must be arranged in ascending order of
+// labels, as tries built with their default orders are.
+class RangeCompleter : public CompleterBase
+{
+public:
+	RangeCompleter() : trie_(NULL), start_index_(0), indices_(), key_(),
+		upper_bound_(), value_(TrieBase::INVALID_VALUE), step_(VISIT_STEP) {}
+	~RangeCompleter() { clear(); }
+
+	bool start(const TrieBase &trie, UInt32 index);
+	// Moves to the first key that is not less than lower_bound.
+	void seek(const char *lower_bound);
+	// Stops before the first key that is not less than upper_bound, or
+	// removes the upper bound if upper_bound is NULL.
+	void set_upper_bound(const char *upper_bound);
+	bool next();
+
+	const char *key() const;
+	UInt32 length() const { return key_.size() - 1; }
+	UInt32 value() const { return value_; }
+
+	void clear();
+
+private:
+	enum Step
+	{
+		// Checks the value of the last node.
+		VISIT_STEP,
+		// Moves to the next node in preorder.
+		DESCEND_STEP,
+		// Moves to the next node after the subtree of the last node.
+		SKIP_STEP
+	};
+
+	const TrieBase *trie_;
+	UInt32 start_index_;
+	std::vector<UInt32> indices_;
+	std::vector<UInt8> key_;
+	std::vector<UInt8> upper_bound_;
+	UInt32 value_;
+	Step step_;
+
+	// Disallows copies.
+	RangeCompleter(const RangeCompleter &);
+	RangeCompleter &operator=(const RangeCompleter &);
+
+	bool find_next(bool descends);
+	bool is_below_upper_bound() const;
+
+	void push_node(UInt32 index);
+	void pop_node();
+};
+
+}  // namespace sumire
+
+#include "range-completer-in.h"
+
+#endif  // SUMIRE_RANGE_COMPLETER_H
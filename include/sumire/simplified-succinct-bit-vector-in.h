@@ -2,38 +2,117 @@
 #define SUMIRE_SIMPLIFIED_SUCCINCT_BIT_VECTOR_IN_H
 
 #include "object-io.h"
-#include "select-table.h"
+#include "pop-count.h"
+#include "word-select.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace sumire {
 
 inline void SimplifiedSuccinctBitVector::build(const BitVector &bv)
 {
+	if (bv.is_contiguous())
+	{
+		build(bv.units(), bv.num_bits());
+		return;
+	}
+
+	ObjectArray<UInt32> units;
+	units.resize((bv.num_bits() + BITS_PER_UNIT - 1) / BITS_PER_UNIT);
+	for (UInt32 unit_id = 0; unit_id < units.num_objs(); ++unit_id)
+		units[unit_id] = bv.unit(unit_id);
+
+	build(units.begin(), bv.num_bits());
+}
+
+// Units are interleaved with ranks, so this function only clears *bv after
+// building, like build(ObjectArray<UInt32> *, UInt32).
+inline void SimplifiedSuccinctBitVector::build(BitVector *bv)
+{
+	assert(bv != NULL);
+
+	build(*bv);
+	bv->clear();
+}
+
+inline void SimplifiedSuccinctBitVector::build(
+	const UInt32 *units_ptr, UInt32 num_bits)
+{
+	assert(units_ptr != NULL || num_bits == 0);
+
+	UInt32 num_units = (num_bits + BITS_PER_UNIT - 1) / BITS_PER_UNIT;
+	UInt32 num_chunks = (num_units + UNITS_PER_CHUNK - 1) / UNITS_PER_CHUNK;
+
 	ObjectArray<Unit> units;
-	units.resize(bv.num_units());
+	units.resize(num_units);
+	ObjectArray<UInt32> chunk_ranks;
+	chunk_ranks.resize(num_chunks);
+
+	// The first pass copies units with ranks in each chunk, the second pass
+	// converts the counts of 1s in chunks into ranks, and the last pass
+	// adds them to the ranks of units without counting 1s again. The second
+	// pass reads one word per chunk, so it is left serial.
+#ifdef _OPENMP
+#pragma omp parallel for if (num_chunks >= MIN_PARALLEL_NUM_CHUNKS)
+#endif  // _OPENMP
+	for (UInt32 chunk_id = 0; chunk_id < num_chunks; ++chunk_id)
+	{
+		UInt32 begin = chunk_id * UNITS_PER_CHUNK;
+		UInt32 end = std::min(begin + UNITS_PER_CHUNK, num_units);
+
+		UInt32 count = 0;
+		for (UInt32 unit_id = begin; unit_id < end; ++unit_id)
+		{
+			units[unit_id].set_value(units_ptr[unit_id]);
+			units[unit_id].set_rank(count);
+			count += count_unit(units_ptr, num_bits, unit_id);
+		}
+		chunk_ranks[chunk_id] = count;
+	}
 
 	UInt32 num_ones = 0;
-	for (UInt32 unit_id = 0; unit_id < bv.num_units(); ++unit_id)
+	for (UInt32 chunk_id = 0; chunk_id < num_chunks; ++chunk_id)
 	{
-		units[unit_id].set_rank(num_ones);
-		units[unit_id].set_value(bv.unit(unit_id));
+		UInt32 count = chunk_ranks[chunk_id];
+		chunk_ranks[chunk_id] = num_ones;
+		num_ones += count;
+	}
 
-		UInt32 left_bits = bv.num_bits() - unit_id * BITS_PER_UNIT;
-		UInt32 left_shift = 0;
-		if (left_bits < BITS_PER_UNIT)
-			left_shift = BITS_PER_UNIT - left_bits;
+#ifdef _OPENMP
+#pragma omp parallel for if (num_chunks >= MIN_PARALLEL_NUM_CHUNKS)
+#endif  // _OPENMP
+	for (UInt32 chunk_id = 0; chunk_id < num_chunks; ++chunk_id)
+	{
+		UInt32 begin = chunk_id * UNITS_PER_CHUNK;
+		UInt32 end = std::min(begin + UNITS_PER_CHUNK, num_units);
 
-		UInt32 count = pop_count(bv.unit(unit_id) << left_shift) >> 24;
-		num_ones += count;
+		UInt32 rank = chunk_ranks[chunk_id];
+		for (UInt32 unit_id = begin; unit_id < end; ++unit_id)
+			units[unit_id].set_rank(units[unit_id].rank() + rank);
 	}
 
 	clear();
 	units_.swap(&units);
-	num_bits_ = bv.num_bits();
+	num_bits_ = num_bits;
 	num_ones_ = num_ones;
 }
 
+// Units are interleaved with ranks, so this function cannot reuse *units_ptr.
+// It is cleared to release memory as early as possible.
+inline void SimplifiedSuccinctBitVector::build(
+	ObjectArray<UInt32> *units_ptr, UInt32 num_bits)
+{
+	assert(units_ptr != NULL);
+	assert(units_ptr->num_objs() ==
+		(num_bits + BITS_PER_UNIT - 1) / BITS_PER_UNIT);
+
+	ObjectArray<UInt32> units;
+	units.swap(units_ptr);
+
+	build(units.begin(), num_bits);
+}
+
 inline UInt32 SimplifiedSuccinctBitVector::rank_1(UInt32 index) const
 {
 	assert(index < num_bits());
@@ -52,41 +131,44 @@ inline UInt32 SimplifiedSuccinctBitVector::rank_0(UInt32 index) const
 	return index - rank_1(index) + 1;
 }
 
-inline UInt32 SimplifiedSuccinctBitVector::select_1(UInt32 count) const
+inline void SimplifiedSuccinctBitVector::rank_1(const UInt32 *indices,
+	UInt32 num_indices, UInt32 *ranks) const
 {
-	assert(count > 0);
-	assert(count <= num_ones());
+	assert(indices != NULL || num_indices == 0);
+	assert(ranks != NULL || num_indices == 0);
 
-	UInt32 left = 0;
-	UInt32 right = num_units();
-	while (left + 1 < right)
+	for (UInt32 i = 0; i < num_indices; ++i)
 	{
-		UInt32 middle = (left + right) / 2;
-		if (units_[middle].rank() >= count)
-			right = middle;
-		else
-			left = middle;
+		assert(indices[i] < num_bits());
+		assert((i == 0) || (indices[i - 1] <= indices[i]));
+
+#ifdef __GNUC__
+		if (i + PREFETCH_DISTANCE < num_indices)
+			__builtin_prefetch(&units_[
+				indices[i + PREFETCH_DISTANCE] / BITS_PER_UNIT]);
+#endif  // __GNUC__
+
+		UInt32 unit_id = indices[i] / BITS_PER_UNIT;
+		UInt32 bit_id = indices[i] % BITS_PER_UNIT;
+		ranks[i] = units_[unit_id].rank() + (pop_count(units_[unit_id].value()
+			& (~UNIT_0 >> (BITS_PER_UNIT - bit_id - 1))) >> 24);
 	}
-	UInt32 unit_id = left;
-	count -= units_[unit_id].rank();
-
-	UInt32 index = unit_id * BITS_PER_UNIT;
-	UInt32 unit = units_[unit_id].value();
-	UInt32 bytes = pop_count(unit);
-
-	UInt64 offset = 0;
-	if (count <= ((bytes << 16) >> 24))
-		offset += 16;
-	if (count <= ((bytes << (offset + 8)) >> 24))
-		offset += 8;
+}
 
-	count -= ((bytes << offset) << 8) >> 24;
-	unit >>= BITS_PER_UNIT - (offset + 8);
-	index += BITS_PER_UNIT - (offset + 8);
+inline void SimplifiedSuccinctBitVector::rank_0(const UInt32 *indices,
+	UInt32 num_indices, UInt32 *ranks) const
+{
+	rank_1(indices, num_indices, ranks);
+	for (UInt32 i = 0; i < num_indices; ++i)
+		ranks[i] = indices[i] - ranks[i] + 1;
+}
 
-	index += SelectTable::lookup(true, count, unit);
+inline UInt32 SimplifiedSuccinctBitVector::select_1(UInt32 count) const
+{
+	assert(count > 0);
+	assert(count <= num_ones());
 
-	return index - 1;
+	return select_1_in_unit(search_unit_1(0, num_units(), count), count);
 }
 
 inline UInt32 SimplifiedSuccinctBitVector::select_0(UInt32 count) const
@@ -94,36 +176,75 @@ inline UInt32 SimplifiedSuccinctBitVector::select_0(UInt32 count) const
 	assert(count > 0);
 	assert(count <= num_zeros());
 
-	UInt32 left = 0;
-	UInt32 right = num_units();
-	while (left + 1 < right)
-	{
-		UInt32 middle = (left + right) / 2;
-		if ((middle * BITS_PER_UNIT) - units_[middle].rank() >= count)
-			right = middle;
-		else
-			left = middle;
-	}
-	UInt32 unit_id = left;
-	count -= (unit_id * BITS_PER_UNIT) - units_[unit_id].rank();
-
-	UInt32 index = unit_id * BITS_PER_UNIT;
-	UInt32 unit = units_[unit_id].value();
-	UInt32 bytes = pop_count(~unit);
+	return select_0_in_unit(search_unit_0(0, num_units(), count), count);
+}
 
-	UInt64 offset = 0;
-	if (count <= ((bytes << 16) >> 24))
-		offset += 16;
-	if (count <= ((bytes << (offset + 8)) >> 24))
-		offset += 8;
+inline void SimplifiedSuccinctBitVector::select_1(const UInt32 *counts,
+	UInt32 num_counts, UInt32 *indices) const
+{
+	assert(counts != NULL || num_counts == 0);
+	assert(indices != NULL || num_counts == 0);
 
-	count -= ((bytes << offset) << 8) >> 24;
-	unit >>= BITS_PER_UNIT - (offset + 8);
-	index += BITS_PER_UNIT - (offset + 8);
+	// The search for each count starts from the unit of the previous one
+	// and gallops forward.
+	UInt32 unit_id = 0;
+	for (UInt32 i = 0; i < num_counts; ++i)
+	{
+		assert(counts[i] > 0);
+		assert(counts[i] <= num_ones());
+		assert((i == 0) || (counts[i - 1] <= counts[i]));
+
+		UInt32 left = unit_id;
+		UInt32 right = unit_id + 1;
+		for (UInt32 step = 1; (right < num_units()) &&
+			(units_[right].rank() < counts[i]); step *= 2)
+		{
+			left = right;
+			right = (num_units() - right > step) ?
+				(right + step) : num_units();
+		}
+		unit_id = search_unit_1(left, right, counts[i]);
+
+#ifdef __GNUC__
+		if (unit_id + PREFETCH_DISTANCE < num_units())
+			__builtin_prefetch(&units_[unit_id + PREFETCH_DISTANCE]);
+#endif  // __GNUC__
+
+		indices[i] = select_1_in_unit(unit_id, counts[i]);
+	}
+}
 
-	index += SelectTable::lookup(false, count, unit);
+inline void SimplifiedSuccinctBitVector::select_0(const UInt32 *counts,
+	UInt32 num_counts, UInt32 *indices) const
+{
+	assert(counts != NULL || num_counts == 0);
+	assert(indices != NULL || num_counts == 0);
 
-	return index - 1;
+	UInt32 unit_id = 0;
+	for (UInt32 i = 0; i < num_counts; ++i)
+	{
+		assert(counts[i] > 0);
+		assert(counts[i] <= num_zeros());
+		assert((i == 0) || (counts[i - 1] <= counts[i]));
+
+		UInt32 left = unit_id;
+		UInt32 right = unit_id + 1;
+		for (UInt32 step = 1; (right < num_units()) && ((right
+			* BITS_PER_UNIT) - units_[right].rank() < counts[i]); step *= 2)
+		{
+			left = right;
+			right = (num_units() - right > step) ?
+				(right + step) : num_units();
+		}
+		unit_id = search_unit_0(left, right, counts[i]);
+
+#ifdef __GNUC__
+		if (unit_id + PREFETCH_DISTANCE < num_units())
+			__builtin_prefetch(&units_[unit_id + PREFETCH_DISTANCE]);
+#endif  // __GNUC__
+
+		indices[i] = select_0_in_unit(unit_id, counts[i]);
+	}
 }
 
 inline bool SimplifiedSuccinctBitVector::operator[](UInt32 index) const
@@ -146,6 +267,36 @@ inline bool SimplifiedSuccinctBitVector::get(UInt32 index) const
 	return (units_[unit_id].value() & (UNIT_1 << bit_id)) != 0;
 }
 
+inline UInt32 SimplifiedSuccinctBitVector::unit(UInt32 unit_id) const
+{
+	assert(unit_id < num_units());
+
+	return units_[unit_id].value();
+}
+
+inline UInt32 SimplifiedSuccinctBitVector::run_length_1(UInt32 index) const
+{
+	assert(index < num_bits());
+
+	// The run is measured in units and clipped at the end because the bits
+	// after the last bit are undefined.
+	UInt32 unit_id = index / BITS_PER_UNIT;
+	UInt32 bit_id = index % BITS_PER_UNIT;
+	UInt32 zeros = ~unit(unit_id) >> bit_id;
+
+	UInt32 num_ones = 0;
+	while (zeros == 0)
+	{
+		num_ones += BITS_PER_UNIT - bit_id;
+		if (++unit_id == num_units())
+			return num_bits() - index;
+		bit_id = 0;
+		zeros = ~unit(unit_id);
+	}
+	num_ones += PopCount::count(~zeros & (zeros - 1));
+	return std::min(num_ones, num_bits() - index);
+}
+
 inline void SimplifiedSuccinctBitVector::clear()
 {
 	units_.clear();
@@ -215,6 +366,64 @@ inline void SimplifiedSuccinctBitVector::swap(
 	std::swap(num_ones_, target->num_ones_);
 }
 
+// Bits after the end of the bit vector are not counted.
+inline UInt32 SimplifiedSuccinctBitVector::count_unit(
+	const UInt32 *units, UInt32 num_bits, UInt32 unit_id)
+{
+	UInt32 unit = units[unit_id];
+	if ((unit_id + 1) * BITS_PER_UNIT > num_bits)
+		unit &= ~UNIT_0 >> (BITS_PER_UNIT - (num_bits % BITS_PER_UNIT));
+	return PopCount::count(unit);
+}
+
+// Returns the last unit in [left, right) whose rank is less than count.
+// The rank of left must be less than count.
+inline UInt32 SimplifiedSuccinctBitVector::search_unit_1(
+	UInt32 left, UInt32 right, UInt32 count) const
+{
+	while (left + 1 < right)
+	{
+		UInt32 middle = (left + right) / 2;
+		if (units_[middle].rank() >= count)
+			right = middle;
+		else
+			left = middle;
+	}
+	return left;
+}
+
+inline UInt32 SimplifiedSuccinctBitVector::search_unit_0(
+	UInt32 left, UInt32 right, UInt32 count) const
+{
+	while (left + 1 < right)
+	{
+		UInt32 middle = (left + right) / 2;
+		if ((middle * BITS_PER_UNIT) - units_[middle].rank() >= count)
+			right = middle;
+		else
+			left = middle;
+	}
+	return left;
+}
+
+inline UInt32 SimplifiedSuccinctBitVector::select_1_in_unit(
+	UInt32 unit_id, UInt32 count) const
+{
+	count -= units_[unit_id].rank();
+
+	return (unit_id * BITS_PER_UNIT)
+		+ WordSelect::select_1(units_[unit_id].value(), count);
+}
+
+inline UInt32 SimplifiedSuccinctBitVector::select_0_in_unit(
+	UInt32 unit_id, UInt32 count) const
+{
+	count -= (unit_id * BITS_PER_UNIT) - units_[unit_id].rank();
+
+	return (unit_id * BITS_PER_UNIT)
+		+ WordSelect::select_0(units_[unit_id].value(), count);
+}
+
 inline UInt32 SimplifiedSuccinctBitVector::pop_count(UInt32 unit)
 {
 	unit = ((unit & 0xAAAAAAAA) >> 1) + (unit & 0x55555555);
@@ -39,16 +39,36 @@ public:
 	~SimplifiedSuccinctBitVector() { clear(); }
 
 	void build(const BitVector &bv);
+	void build(BitVector *bv);
+	void build(const UInt32 *units, UInt32 num_bits);
+	void build(ObjectArray<UInt32> *units, UInt32 num_bits);
 
 	UInt32 rank_1(UInt32 index) const;
 	UInt32 rank_0(UInt32 index) const;
 
+	// These functions answer rank queries for sorted indices in one pass.
+	void rank_1(const UInt32 *indices, UInt32 num_indices,
+		UInt32 *ranks) const;
+	void rank_0(const UInt32 *indices, UInt32 num_indices,
+		UInt32 *ranks) const;
+
 	UInt32 select_1(UInt32 count) const;
 	UInt32 select_0(UInt32 count) const;
 
+	// These functions answer select queries for sorted counts in one pass.
+	void select_1(const UInt32 *counts, UInt32 num_counts,
+		UInt32 *indices) const;
+	void select_0(const UInt32 *counts, UInt32 num_counts,
+		UInt32 *indices) const;
+
 	bool operator[](UInt32 index) const;
 	bool get(UInt32 index) const;
 
+	// Returns the unit that holds bits [unit_id * 32, (unit_id + 1) * 32).
+	UInt32 unit(UInt32 unit_id) const;
+	// Returns the length of the run of 1s that starts at index.
+	UInt32 run_length_1(UInt32 index) const;
+
 	UInt32 num_units() const { return units_.num_objs(); }
 	UInt32 num_bits() const { return num_bits_; }
 	UInt32 num_ones() const { return num_ones_; }
@@ -63,6 +83,10 @@ public:
 	void swap(SimplifiedSuccinctBitVector *target);
 
 private:
+	enum { UNITS_PER_CHUNK = 1 << 10 };
+	enum { MIN_PARALLEL_NUM_CHUNKS = 1 << 5 };
+	enum { PREFETCH_DISTANCE = 8 };
+
 	ObjectArray<Unit> units_;
 	UInt32 num_bits_;
 	UInt32 num_ones_;
@@ -72,6 +96,15 @@ private:
 	SimplifiedSuccinctBitVector &operator=(
 		const SimplifiedSuccinctBitVector &);
 
+	static UInt32 count_unit(const UInt32 *units,
+		UInt32 num_bits, UInt32 unit_id);
+
+	UInt32 search_unit_1(UInt32 left, UInt32 right, UInt32 count) const;
+	UInt32 search_unit_0(UInt32 left, UInt32 right, UInt32 count) const;
+
+	UInt32 select_1_in_unit(UInt32 unit_id, UInt32 count) const;
+	UInt32 select_0_in_unit(UInt32 unit_id, UInt32 count) const;
+
 	static UInt32 pop_count(UInt32 unit);
 };
 
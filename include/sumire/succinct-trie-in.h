@@ -15,7 +15,10 @@ inline bool SuccinctTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(
 	if (trie.num_nodes() == 0)
 		return false;
 
-	BitVector tree_bv, has_value_bv;
+	BitVector tree_bv(BitVector::CONTIGUOUS_STORAGE);
+	BitVector has_value_bv(BitVector::CONTIGUOUS_STORAGE);
+	tree_bv.reserve(trie.num_nodes() * 2);
+	has_value_bv.reserve(trie.num_nodes());
 
 	ObjectArray<UInt8> labels;
 	ObjectArray<UInt32> values;
@@ -41,14 +44,15 @@ inline bool SuccinctTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(
 		has_value_bv.add(has_value);
 
 		UInt32 child_index = trie.child(index);
-		tree_bv.add(child_index != 0);
 		if (child_index != 0)
 			queue.push(child_index);
 
 		UInt32 sibling_index = trie.sibling(index);
-		tree_bv.add(sibling_index != 0);
 		if (sibling_index != 0)
 			queue.push(sibling_index);
+
+		tree_bv.append_bits((child_index != 0 ? 1 : 0)
+			| (sibling_index != 0 ? 2 : 0), 2);
 	}
 
 	assert(tree_bv.num_bits() == trie.num_nodes() * 2);
@@ -57,8 +61,8 @@ inline bool SuccinctTrie<SUCCINCT_BIT_VECTOR_TYPE>::build(
 	assert(value_index == values.num_objs());
 
 	SuccinctBitVector tree_sbv, has_value_sbv;
-	tree_sbv.build(tree_bv);
-	has_value_sbv.build(has_value_bv);
+	tree_sbv.build(&tree_bv);
+	has_value_sbv.build(&has_value_bv);
 
 	clear();
 	tree_sbv_.swap(&tree_sbv);
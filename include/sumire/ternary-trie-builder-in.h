@@ -8,7 +8,7 @@
 namespace sumire {
 
 inline bool TernaryTrieBuilder::build(const TrieBase &trie,
-	ObjectArray<TernaryTrieUnit> *units)
+	ObjectArray<TernaryTrieUnit> *units, ObjectArray<UInt8> *labels)
 {
 	assert(units != NULL);
 
@@ -26,6 +26,8 @@ inline bool TernaryTrieBuilder::build(const TrieBase &trie,
 	assert(num_units_ == units_.num_objs());
 
 	build_link();
+	if (labels != NULL)
+		build_labels(labels);
 
 	units_.swap(units);
 	clear();
@@ -127,6 +129,21 @@ inline void TernaryTrieBuilder::build_link()
 	}
 }
 
+inline void TernaryTrieBuilder::build_labels(
+	ObjectArray<UInt8> *labels) const
+{
+	assert(labels != NULL);
+
+	// Labels of leaves are '\0', and they keep the packed labels of each
+	// group sorted as units are.
+	ObjectArray<UInt8> packed_labels;
+	packed_labels.resize(units_.num_objs());
+	for (UInt32 index = 0; index < units_.num_objs(); ++index)
+		packed_labels[index] = units_[index].label();
+
+	packed_labels.swap(labels);
+}
+
 inline void TernaryTrieBuilder::clear()
 {
 	trie_ = NULL;
@@ -13,7 +13,9 @@ public:
 	TernaryTrieBuilder() : trie_(NULL), units_(), num_units_(0) {}
 	~TernaryTrieBuilder() { clear(); }
 
-	bool build(const TrieBase &trie, ObjectArray<TernaryTrieUnit> *units);
+	// If labels is not NULL, a copy of the labels of units is stored in it.
+	bool build(const TrieBase &trie, ObjectArray<TernaryTrieUnit> *units,
+		ObjectArray<UInt8> *labels = NULL);
 
 private:
 	const TrieBase *trie_;
@@ -26,6 +28,7 @@ private:
 
 	void build_trie(UInt32 src_index, UInt32 dest_index);
 	void build_link();
+	void build_labels(ObjectArray<UInt8> *labels) const;
 
 	void clear();
 };
@@ -8,22 +8,30 @@
 
 namespace sumire {
 
-inline bool TernaryTrie::build(const TrieBase &trie)
+inline bool TernaryTrie::build(const TrieBase &trie, Layout layout)
 {
 	ObjectArray<TernaryTrieUnit> units;
+	ObjectArray<UInt8> labels;
 	UInt32 num_keys = trie.num_keys();
 
 	TernaryTrieBuilder builder;
-	if (!builder.build(trie, &units))
+	if (!builder.build(trie, &units,
+		(layout == PACKED_LABEL_LAYOUT) ? &labels : NULL))
 		return false;
 
 	clear();
 	units_.swap(&units);
+	labels_.swap(&labels);
 	num_keys_ = num_keys;
 
 	return true;
 }
 
+inline bool TernaryTrie::build(const TrieBase &trie)
+{
+	return build(trie, UNIT_LAYOUT);
+}
+
 inline UInt32 TernaryTrie::find_child(UInt32 index, UInt8 child_label) const
 {
 	assert(index < num_units());
@@ -33,6 +41,11 @@ inline UInt32 TernaryTrie::find_child(UInt32 index, UInt8 child_label) const
 	if (units_[index].has_leaf())
 		++left;
 
+	// Small groups are searched in units because an extra access to the
+	// packed labels costs more than a few probes on units.
+	if ((right - left) >= MIN_PACKED_SEARCH_SIZE && labels_.num_objs() != 0)
+		return search_labels(left, right, child_label);
+
 	while (left < right)
 	{
 		UInt32 middle = (left + right) / 2;
@@ -101,6 +114,28 @@ inline bool TernaryTrie::get_value(UInt32 index, UInt32 *value_ptr) const
 	return true;
 }
 
+// The range is narrowed with conditional moves instead of branches. The
+// labels of a group fit in 4 cache lines, so prefetching does not pay.
+inline UInt32 TernaryTrie::search_labels(UInt32 left, UInt32 right,
+	UInt8 child_label) const
+{
+	assert(left <= right);
+	assert(right <= labels_.num_objs());
+
+	if (left == right)
+		return 0;
+
+	const UInt8 *labels = labels_.begin();
+	UInt32 num_labels = right - left;
+	while (num_labels > 1)
+	{
+		UInt32 half = num_labels / 2;
+		left += (labels[left + half] <= child_label) ? half : 0;
+		num_labels -= half;
+	}
+	return (labels[left] == child_label) ? left : 0;
+}
+
 inline UInt32 TernaryTrie::num_nodes() const
 {
 	assert(num_keys() <= num_units());
@@ -111,9 +146,12 @@ inline UInt32 TernaryTrie::num_nodes() const
 inline void TernaryTrie::clear()
 {
 	units_.clear();
+	labels_.clear();
 	num_keys_ = 0;
 }
 
+// PACKED_LABEL_LAYOUT is marked by a flag in the number of keys, and then
+// labels follow it. So, UNIT_LAYOUT keeps the format without labels.
 inline void *TernaryTrie::map(void *addr)
 {
 	assert(addr != NULL);
@@ -126,6 +164,12 @@ inline void *TernaryTrie::map(void *addr)
 	num_keys_ = *clipper.clip<UInt32>();
 	addr = clipper.addr();
 
+	if ((num_keys_ & PACKED_LABEL_FLAG) != 0)
+	{
+		num_keys_ &= ~static_cast<UInt32>(PACKED_LABEL_FLAG);
+		addr = labels_.map(addr);
+	}
+
 	return addr;
 }
 
@@ -134,6 +178,7 @@ inline bool TernaryTrie::read(std::istream *input)
 	assert(input != NULL);
 
 	ObjectArray<TernaryTrieUnit> units;
+	ObjectArray<UInt8> labels;
 
 	if (!units.read(input))
 		return false;
@@ -144,8 +189,16 @@ inline bool TernaryTrie::read(std::istream *input)
 	if (!reader.read(&num_keys))
 		return false;
 
+	if ((num_keys & PACKED_LABEL_FLAG) != 0)
+	{
+		num_keys &= ~static_cast<UInt32>(PACKED_LABEL_FLAG);
+		if (!labels.read(input))
+			return false;
+	}
+
 	clear();
 	units_.swap(&units);
+	labels_.swap(&labels);
 	num_keys_ = num_keys;
 
 	return true;
@@ -154,12 +207,20 @@ inline bool TernaryTrie::read(std::istream *input)
 inline bool TernaryTrie::write(std::ostream *output) const
 {
 	assert(output != NULL);
+	assert((num_keys_ & PACKED_LABEL_FLAG) == 0);
 
 	if (!units_.write(output))
 		return false;
 
+	UInt32 num_keys = num_keys_;
+	if (labels_.num_objs() != 0)
+		num_keys |= PACKED_LABEL_FLAG;
+
 	ObjectWriter writer(output);
-	if (!writer.write(num_keys_))
+	if (!writer.write(num_keys))
+		return false;
+
+	if (labels_.num_objs() != 0 && !labels_.write(output))
 		return false;
 
 	return true;
@@ -170,6 +231,7 @@ inline void TernaryTrie::swap(TernaryTrie *target)
 	assert(target != NULL);
 
 	units_.swap(&target->units_);
+	labels_.swap(&target->labels_);
 	std::swap(num_keys_, target->num_keys_);
 }
 
@@ -9,9 +9,19 @@ namespace sumire {
 
 class TernaryTrie : public TrieBase
 {
+public:
+	// PACKED_LABEL_LAYOUT keeps a copy of labels in a byte array, and then
+	// find_child() performs a branchless binary search on it.
+	enum Layout
+	{
+		UNIT_LAYOUT,
+		PACKED_LABEL_LAYOUT
+	};
+
+	bool build(const TrieBase &trie, Layout layout);
 
 public:
-	TernaryTrie() : units_(), num_keys_(0) {}
+	TernaryTrie() : units_(), labels_(), num_keys_(0) {}
 	~TernaryTrie() { clear(); }
 
 	bool build(const TrieBase &trie);
@@ -27,7 +37,7 @@ public:
 	UInt32 num_units() const { return units_.num_objs(); }
 	UInt32 num_nodes() const;
 	UInt32 num_keys() const { return num_keys_; }
-	UInt32 size() const { return units_.size(); }
+	UInt32 size() const { return units_.size() + labels_.size(); }
 
 	void clear();
 	void *map(void *addr);
@@ -37,12 +47,18 @@ public:
 	void swap(TernaryTrie *target);
 
 private:
+	enum { MIN_PACKED_SEARCH_SIZE = 16 };
+	enum { PACKED_LABEL_FLAG = 1U << 31 };
+
 	ObjectArray<TernaryTrieUnit> units_;
+	ObjectArray<UInt8> labels_;
 	UInt32 num_keys_;
 
 	// Disallows copies.
 	TernaryTrie(const TernaryTrie &);
 	TernaryTrie &operator=(const TernaryTrie &);
+
+	UInt32 search_labels(UInt32 left, UInt32 right, UInt8 child_label) const;
 };
 
 }  // namespace sumire
@@ -0,0 +1,226 @@
+#ifndef SUMIRE_TOP_K_CACHE_IN_H
+#define SUMIRE_TOP_K_CACHE_IN_H
+
+#include "key-count-table.h"
+#include "max-value-table.h"
+#include "object-io.h"
+#include "top-k-completer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace sumire {
+
+inline void TopKCache::build(const TrieBase &trie, UInt32 num_results,
+	UInt32 min_num_keys)
+{
+	KeyCountTable key_counts;
+	key_counts.build(trie);
+
+	MaxValueTable max_values;
+	max_values.build(trie);
+
+	std::vector<UInt32> indices;
+	std::vector<UInt32> result_begins;
+	std::vector<UInt32> key_begins;
+	std::vector<char> keys;
+	std::vector<UInt32> values;
+
+	TopKCompleter completer;
+	for (UInt32 index = 0; index < key_counts.num_units(); ++index)
+	{
+		UInt32 num_keys = key_counts.num_keys(index);
+		if (num_keys == 0 || num_keys < min_num_keys)
+			continue;
+
+		indices.push_back(index);
+		result_begins.push_back(static_cast<UInt32>(values.size()));
+
+		completer.start(trie, max_values, index, num_results);
+		while (completer.next())
+		{
+			key_begins.push_back(static_cast<UInt32>(keys.size()));
+			keys.insert(keys.end(), completer.key(),
+				completer.key() + completer.length() + 1);
+			values.push_back(completer.value());
+		}
+	}
+	result_begins.push_back(static_cast<UInt32>(values.size()));
+	key_begins.push_back(static_cast<UInt32>(keys.size()));
+
+	ObjectArray<UInt32> index_array, result_begin_array, key_begin_array;
+	index_array.resize(static_cast<UInt32>(indices.size()));
+	std::copy(indices.begin(), indices.end(), index_array.begin());
+	result_begin_array.resize(static_cast<UInt32>(result_begins.size()));
+	std::copy(result_begins.begin(), result_begins.end(),
+		result_begin_array.begin());
+	key_begin_array.resize(static_cast<UInt32>(key_begins.size()));
+	std::copy(key_begins.begin(), key_begins.end(), key_begin_array.begin());
+
+	ObjectArray<char> key_array;
+	key_array.resize(static_cast<UInt32>(keys.size()));
+	std::copy(keys.begin(), keys.end(), key_array.begin());
+
+	ObjectArray<UInt32> value_array;
+	value_array.resize(static_cast<UInt32>(values.size()));
+	std::copy(values.begin(), values.end(), value_array.begin());
+
+	clear();
+	indices_.swap(&index_array);
+	result_begins_.swap(&result_begin_array);
+	key_begins_.swap(&key_begin_array);
+	keys_.swap(&key_array);
+	values_.swap(&value_array);
+	num_results_ = num_results;
+}
+
+inline bool TopKCache::find(UInt32 index, UInt32 *id_ptr) const
+{
+	assert(id_ptr != NULL);
+
+	const UInt32 *it = std::lower_bound(
+		indices_.begin(), indices_.end(), index);
+	if (it == indices_.end() || *it != index)
+		return false;
+
+	*id_ptr = static_cast<UInt32>(it - indices_.begin());
+	return true;
+}
+
+inline UInt32 TopKCache::result_begin(UInt32 id) const
+{
+	assert(id < num_nodes());
+
+	return result_begins_[id];
+}
+
+inline UInt32 TopKCache::result_end(UInt32 id) const
+{
+	assert(id < num_nodes());
+
+	return result_begins_[id + 1];
+}
+
+inline const char *TopKCache::key(UInt32 result_id) const
+{
+	assert(result_id < values_.num_objs());
+
+	return &keys_[key_begins_[result_id]];
+}
+
+inline UInt32 TopKCache::length(UInt32 result_id) const
+{
+	assert(result_id < values_.num_objs());
+
+	return key_begins_[result_id + 1] - key_begins_[result_id] - 1;
+}
+
+inline UInt32 TopKCache::value(UInt32 result_id) const
+{
+	assert(result_id < values_.num_objs());
+
+	return values_[result_id];
+}
+
+inline UInt32 TopKCache::size() const
+{
+	return indices_.size() + result_begins_.size() + key_begins_.size() +
+		keys_.size() + values_.size();
+}
+
+inline void TopKCache::clear()
+{
+	indices_.clear();
+	result_begins_.clear();
+	key_begins_.clear();
+	keys_.clear();
+	values_.clear();
+	num_results_ = 0;
+}
+
+inline void *TopKCache::map(void *addr)
+{
+	assert(addr != NULL);
+
+	clear();
+
+	addr = indices_.map(addr);
+	addr = result_begins_.map(addr);
+	addr = key_begins_.map(addr);
+	addr = keys_.map(addr);
+	addr = values_.map(addr);
+
+	ObjectClipper clipper(addr);
+	num_results_ = *clipper.clip<UInt32>();
+	addr = clipper.addr();
+
+	return addr;
+}
+
+inline bool TopKCache::read(std::istream *input)
+{
+	assert(input != NULL);
+
+	ObjectArray<UInt32> indices, result_begins, key_begins;
+	if (!indices.read(input) || !result_begins.read(input))
+		return false;
+	if (!key_begins.read(input))
+		return false;
+
+	ObjectArray<char> keys;
+	ObjectArray<UInt32> values;
+	if (!keys.read(input) || !values.read(input))
+		return false;
+
+	ObjectReader reader(input);
+
+	UInt32 num_results;
+	if (!reader.read(&num_results))
+		return false;
+
+	clear();
+	indices_.swap(&indices);
+	result_begins_.swap(&result_begins);
+	key_begins_.swap(&key_begins);
+	keys_.swap(&keys);
+	values_.swap(&values);
+	num_results_ = num_results;
+
+	return true;
+}
+
+inline bool TopKCache::write(std::ostream *output) const
+{
+	assert(output != NULL);
+
+	if (!indices_.write(output) || !result_begins_.write(output))
+		return false;
+	if (!key_begins_.write(output))
+		return false;
+
+	if (!keys_.write(output) || !values_.write(output))
+		return false;
+
+	ObjectWriter writer(output);
+	if (!writer.write(num_results_))
+		return false;
+
+	return true;
+}
+
+inline void TopKCache::swap(TopKCache *target)
+{
+	assert(target != NULL);
+
+	indices_.swap(&target->indices_);
+	result_begins_.swap(&target->result_begins_);
+	key_begins_.swap(&target->key_begins_);
+	keys_.swap(&target->keys_);
+	values_.swap(&target->values_);
+	std::swap(num_results_, target->num_results_);
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_TOP_K_CACHE_IN_H
@@ -0,0 +1,70 @@
+#ifndef SUMIRE_TOP_K_CACHE_H
+#define SUMIRE_TOP_K_CACHE_H
+
+#include "object-array.h"
+#include "trie-base.h"
+
+namespace sumire {
+
+// TopKCache keeps the keys with the greatest values for each node that has
+// many keys in its subtree. The keys are stored as suffixes from the node,
+// and nodes are kept in ascending order of their indices.
+class TopKCache
+{
+public:
+	enum
+	{
+		DEFAULT_NUM_RESULTS = 10,
+		DEFAULT_MIN_NUM_KEYS = 1000
+	};
+
+	TopKCache() : indices_(), result_begins_(), key_begins_(), keys_(),
+		values_(), num_results_(0) {}
+	~TopKCache() { clear(); }
+
+	// Caches up to num_results keys for each node that has min_num_keys or
+	// more keys in its subtree.
+	void build(const TrieBase &trie,
+		UInt32 num_results = DEFAULT_NUM_RESULTS,
+		UInt32 min_num_keys = DEFAULT_MIN_NUM_KEYS);
+
+	// Finds the cache ID of a node.
+	bool find(UInt32 index, UInt32 *id_ptr) const;
+
+	// Results of a node are in [result_begin(id), result_end(id)).
+	UInt32 result_begin(UInt32 id) const;
+	UInt32 result_end(UInt32 id) const;
+
+	const char *key(UInt32 result_id) const;
+	UInt32 length(UInt32 result_id) const;
+	UInt32 value(UInt32 result_id) const;
+
+	UInt32 num_results() const { return num_results_; }
+	UInt32 num_nodes() const { return indices_.num_objs(); }
+	UInt32 size() const;
+
+	void clear();
+	void *map(void *addr);
+	bool read(std::istream *input);
+	bool write(std::ostream *output) const;
+
+	void swap(TopKCache *target);
+
+private:
+	ObjectArray<UInt32> indices_;
+	ObjectArray<UInt32> result_begins_;
+	ObjectArray<UInt32> key_begins_;
+	ObjectArray<char> keys_;
+	ObjectArray<UInt32> values_;
+	UInt32 num_results_;
+
+	// Disallows copies.
+	TopKCache(const TopKCache &);
+	TopKCache &operator=(const TopKCache &);
+};
+
+}  // namespace sumire
+
+#include "top-k-cache-in.h"
+
+#endif  // SUMIRE_TOP_K_CACHE_H
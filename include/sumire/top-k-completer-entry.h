@@ -0,0 +1,40 @@
+#ifndef SUMIRE_TOP_K_COMPLETER_ENTRY_H
+#define SUMIRE_TOP_K_COMPLETER_ENTRY_H
+
+#include "int-types.h"
+
+namespace sumire {
+
+// An entry is either a key with its value or a subtree with the maximum
+// value in it. A key is taken before a subtree with the same value.
+class TopKCompleterEntry
+{
+public:
+	TopKCompleterEntry() : index_(0), value_(0), is_key_(false) {}
+	TopKCompleterEntry(UInt32 index, UInt32 value, bool is_key)
+		: index_(index), value_(value), is_key_(is_key) {}
+
+	UInt32 index() const { return index_; }
+	UInt32 value() const { return value_; }
+	bool is_key() const { return is_key_; }
+
+	bool operator<(const TopKCompleterEntry &rhs) const
+	{
+		if (value_ != rhs.value_)
+			return value_ < rhs.value_;
+		else if (is_key_ != rhs.is_key_)
+			return rhs.is_key_;
+		return index_ > rhs.index_;
+	}
+
+private:
+	UInt32 index_;
+	UInt32 value_;
+	bool is_key_;
+
+	// Copyable.
+};
+
+}  // namespace sumire
+
+#endif  // SUMIRE_TOP_K_COMPLETER_ENTRY_H
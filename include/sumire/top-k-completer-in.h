@@ -0,0 +1,363 @@
+#ifndef SUMIRE_TOP_K_COMPLETER_IN_H
+#define SUMIRE_TOP_K_COMPLETER_IN_H
+
+#include "top-k-cache.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+namespace sumire {
+
+inline bool TopKCompleter::start(const TrieBase &trie, UInt32 index)
+{
+	return start(trie, index, static_cast<UInt32>(-1));
+}
+
+inline bool TopKCompleter::start(const TrieBase &trie, UInt32 index,
+	UInt32 max_num_results, const TopKCache *cache)
+{
+	if (trie.num_units() == 0)
+		return false;
+
+	assert(index < trie.num_units());
+
+	clear();
+
+	trie_ = &trie;
+	max_num_results_ = max_num_results;
+	if (start_with_cache(cache, index))
+		return true;
+
+	// The start node has no bound yet, and INVALID_VALUE puts it first.
+	push_entry(add_node(index, 0), TrieBase::INVALID_VALUE, false);
+
+	return true;
+}
+
+inline bool TopKCompleter::start(const TrieBase &trie,
+	const MaxValueTable &max_values, UInt32 index, UInt32 max_num_results,
+	const TopKCache *cache)
+{
+	if (trie.num_units() == 0)
+		return false;
+
+	assert(index < trie.num_units());
+	assert(max_values.num_units() == trie.num_units());
+
+	clear();
+
+	trie_ = &trie;
+	max_values_ = &max_values;
+	max_num_results_ = max_num_results;
+	if (start_with_cache(cache, index))
+		return true;
+
+	// Sorted children end with INVALID_VALUE, and the start node refers to
+	// an end as its next sibling.
+	children_.push_back(
+		std::make_pair(static_cast<UInt32>(TrieBase::INVALID_VALUE), 0U));
+	enqueue_node(index, 0, max_values[index]);
+
+	return true;
+}
+
+inline bool TopKCompleter::next()
+{
+	assert(trie_ != NULL);
+
+	if (num_results_ >= max_num_results_)
+		return false;
+	else if (cache_ != NULL)
+		return next_in_cache();
+
+	while (!entries_.empty())
+	{
+		TopKCompleterEntry entry = entries_.front();
+		std::pop_heap(entries_.begin(), entries_.end());
+		entries_.pop_back();
+
+		if (entry.is_key())
+		{
+			restore_key(entry.index());
+			value_ = entry.value();
+			++num_results_;
+			return true;
+		}
+		expand(entry.index(), entry.value());
+	}
+
+	return false;
+}
+
+inline const char *TopKCompleter::key() const
+{
+	assert(key_.size() > 0);
+
+	return &key_[0];
+}
+
+inline void TopKCompleter::clear()
+{
+	trie_ = NULL;
+	max_values_ = NULL;
+	cache_ = NULL;
+	key_.clear();
+	value_ = TrieBase::INVALID_VALUE;
+	num_results_ = 0;
+	max_num_results_ = 0;
+	result_id_ = 0;
+	nodes_.clear();
+	entries_.clear();
+	children_.clear();
+	path_indices_.clear();
+	path_values_.clear();
+	path_max_values_.clear();
+}
+
+// A cached node is usable if it has as many results as requested, or if
+// its results are all the keys in its subtree.
+inline bool TopKCompleter::start_with_cache(const TopKCache *cache,
+	UInt32 index)
+{
+	UInt32 id;
+	if (cache == NULL || !cache->find(index, &id))
+		return false;
+
+	UInt32 num_cached_results =
+		cache->result_end(id) - cache->result_begin(id);
+	if (num_cached_results < max_num_results_ &&
+		num_cached_results == cache->num_results())
+		return false;
+
+	cache_ = cache;
+	result_id_ = cache->result_begin(id);
+	max_num_results_ = std::min(max_num_results_, num_cached_results);
+
+	return true;
+}
+
+inline bool TopKCompleter::next_in_cache()
+{
+	assert(cache_ != NULL);
+
+	key_.assign(cache_->key(result_id_),
+		cache_->key(result_id_) + cache_->length(result_id_) + 1);
+	value_ = cache_->value(result_id_);
+	++result_id_;
+	++num_results_;
+
+	return true;
+}
+
+// With a MaxValueTable, only the child with the greatest maximum value is
+// added, and each child adds its next sibling when it is expanded, because
+// the maximum value of the sibling is not greater than its own. A child
+// that has the same maximum value as its parent is expanded at once.
+inline void TopKCompleter::expand(UInt32 node_index, UInt32 max_value)
+{
+	assert(node_index < nodes_.size());
+
+	if (max_values_ == NULL)
+	{
+		expand_path(node_index, max_value);
+		return;
+	}
+
+	for ( ; ; )
+	{
+		enqueue_sibling(node_index);
+
+		UInt32 value;
+		if (trie_->get_value(nodes_[node_index].trie_index(), &value))
+			push_entry(node_index, value, true);
+
+		node_index = add_child(node_index);
+		if (node_index == 0)
+			return;
+
+		UInt32 child_max_value =
+			(*max_values_)[nodes_[node_index].trie_index()];
+		if (child_max_value != max_value)
+		{
+			push_entry(node_index, child_max_value, false);
+			return;
+		}
+	}
+}
+
+// In MAX_VALUE_ORDER, a sibling is added with the maximum value of the
+// path beside it, which bounds its subtree. The bound is made exact when
+// the sibling reaches the top of the queue, and the sibling goes back to
+// the queue if its maximum value is less than the bound.
+inline void TopKCompleter::expand_path(UInt32 node_index, UInt32 max_value)
+{
+	assert(node_index < nodes_.size());
+
+	path_indices_.clear();
+	UInt32 trie_index = nodes_[node_index].trie_index();
+	do
+	{
+		path_indices_.push_back(trie_index);
+		trie_index = trie_->child(trie_index);
+	} while (trie_index != 0);
+
+	path_values_.resize(path_indices_.size());
+	path_max_values_.resize(path_indices_.size());
+	UInt32 path_max_value = TrieBase::INVALID_VALUE;
+	for (std::size_t i = path_indices_.size(); i > 0; --i)
+	{
+		path_values_[i - 1] = trie_->value(path_indices_[i - 1]);
+		path_max_value = MaxValueTable::max_value(
+			path_max_value, path_values_[i - 1]);
+		path_max_values_[i - 1] = path_max_value;
+	}
+
+	if (path_max_value == TrieBase::INVALID_VALUE)
+		return;
+	else if (path_max_value < max_value)
+	{
+		push_entry(node_index, path_max_value, false);
+		return;
+	}
+
+	// The start node is expanded without its siblings.
+	UInt32 parent = nodes_[node_index].parent();
+	for (std::size_t i = 0; i < path_indices_.size(); ++i)
+	{
+		trie_index = path_indices_[i];
+		if (i != 0)
+		{
+			parent = node_index;
+			node_index = add_node(trie_index, parent);
+		}
+
+		if (path_values_[i] != TrieBase::INVALID_VALUE)
+			push_entry(node_index, path_values_[i], true);
+
+		if (node_index != 0)
+		{
+			UInt32 sibling_index = trie_->sibling(trie_index);
+			if (sibling_index != 0)
+				push_entry(add_node(sibling_index, parent),
+					path_max_values_[i], false);
+		}
+	}
+}
+
+inline void TopKCompleter::enqueue_node(UInt32 trie_index, UInt32 parent,
+	UInt32 max_value)
+{
+	if (max_value != TrieBase::INVALID_VALUE)
+		push_entry(add_node(trie_index, parent), max_value, false);
+}
+
+// The start node is expanded without its siblings.
+inline void TopKCompleter::enqueue_sibling(UInt32 node_index)
+{
+	assert(node_index < nodes_.size());
+
+	if (max_values_->in_max_value_order())
+	{
+		if (node_index == 0)
+			return;
+
+		UInt32 sibling_index =
+			trie_->sibling(nodes_[node_index].trie_index());
+		if (sibling_index != 0)
+			enqueue_node(sibling_index, nodes_[node_index].parent(),
+				(*max_values_)[sibling_index]);
+		return;
+	}
+
+	UInt32 sibling_id = nodes_[node_index].sibling();
+	if (children_[sibling_id].first != TrieBase::INVALID_VALUE)
+	{
+		push_entry(add_sorted_child(sibling_id, nodes_[node_index].parent()),
+			children_[sibling_id].first, false);
+	}
+}
+
+// Adds the child with the greatest maximum value, and returns 0 if there
+// is no child with values. Children are sorted unless the table says that
+// they are in order.
+inline UInt32 TopKCompleter::add_child(UInt32 node_index)
+{
+	assert(node_index < nodes_.size());
+
+	UInt32 trie_index = nodes_[node_index].trie_index();
+	if (max_values_->in_max_value_order())
+	{
+		UInt32 child_index = trie_->child(trie_index);
+		if (child_index == 0 ||
+			(*max_values_)[child_index] == TrieBase::INVALID_VALUE)
+			return 0;
+		return add_node(child_index, node_index);
+	}
+
+	std::size_t begin = children_.size();
+	for (UInt32 child_index = trie_->child(trie_index); child_index != 0;
+		child_index = trie_->sibling(child_index))
+	{
+		UInt32 child_max_value = (*max_values_)[child_index];
+		if (child_max_value != TrieBase::INVALID_VALUE)
+			children_.push_back(std::make_pair(child_max_value, child_index));
+	}
+	if (children_.size() == begin)
+		return 0;
+
+	std::sort(children_.begin() + begin, children_.end(),
+		std::greater<std::pair<UInt32, UInt32> >());
+	children_.push_back(
+		std::make_pair(static_cast<UInt32>(TrieBase::INVALID_VALUE), 0U));
+
+	return add_sorted_child(static_cast<UInt32>(begin), node_index);
+}
+
+inline UInt32 TopKCompleter::add_sorted_child(UInt32 child_id, UInt32 parent)
+{
+	assert(child_id < children_.size());
+
+	UInt32 node_index = add_node(children_[child_id].second, parent);
+	nodes_[node_index].set_sibling(child_id + 1);
+	return node_index;
+}
+
+inline UInt32 TopKCompleter::add_node(UInt32 trie_index, UInt32 parent)
+{
+	assert(trie_index < trie_->num_units());
+	assert((parent == 0 && nodes_.size() == 0) || parent < nodes_.size());
+
+	UInt32 node_index = nodes_.size();
+	nodes_.resize(node_index + 1);
+
+	nodes_[node_index].set_trie_index(trie_index);
+	nodes_[node_index].set_parent(parent);
+	nodes_[node_index].set_label(trie_->label(trie_index));
+
+	return node_index;
+}
+
+inline void TopKCompleter::push_entry(UInt32 node_index, UInt32 value,
+	bool is_key)
+{
+	assert(node_index < nodes_.size());
+
+	entries_.push_back(TopKCompleterEntry(node_index, value, is_key));
+	std::push_heap(entries_.begin(), entries_.end());
+}
+
+inline void TopKCompleter::restore_key(UInt32 node_index)
+{
+	assert(node_index < nodes_.size());
+
+	key_.clear();
+	for ( ; node_index != 0; node_index = nodes_[node_index].parent())
+		key_.push_back(nodes_[node_index].label());
+	std::reverse(key_.begin(), key_.end());
+	key_.push_back('\0');
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_TOP_K_COMPLETER_IN_H
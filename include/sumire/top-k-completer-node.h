@@ -0,0 +1,37 @@
+#ifndef SUMIRE_TOP_K_COMPLETER_NODE_H
+#define SUMIRE_TOP_K_COMPLETER_NODE_H
+
+#include "int-types.h"
+
+namespace sumire {
+
+// With a MaxValueTable, sibling() gives the position of the next sibling
+// in the sorted children of the parent.
+class TopKCompleterNode
+{
+public:
+	TopKCompleterNode() : trie_index_(0), parent_(0), sibling_(0),
+		label_('\0') {}
+
+	void set_trie_index(UInt32 index) { trie_index_ = index; }
+	void set_parent(UInt32 index) { parent_ = index; }
+	void set_sibling(UInt32 id) { sibling_ = id; }
+	void set_label(UInt8 label) { label_ = label; }
+
+	UInt32 trie_index() const { return trie_index_; }
+	UInt32 parent() const { return parent_; }
+	UInt32 sibling() const { return sibling_; }
+	UInt8 label() const { return label_; }
+
+private:
+	UInt32 trie_index_;
+	UInt32 parent_;
+	UInt32 sibling_;
+	UInt8 label_;
+
+	// Copyable.
+};
+
+}  // namespace sumire
+
+#endif  // SUMIRE_TOP_K_COMPLETER_NODE_H
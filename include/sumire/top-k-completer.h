@@ -0,0 +1,88 @@
+#ifndef SUMIRE_TOP_K_COMPLETER_H
+#define SUMIRE_TOP_K_COMPLETER_H
+
+#include "completer-base.h"
+#include "max-value-table.h"
+#include "top-k-completer-entry.h"
+#include "top-k-completer-node.h"
+
+#include <utility>
+#include <vector>
+
+namespace sumire {
+
+class TopKCache;
+
+// TopKCompleter enumerates keys in descending order of values, and expands
+// only the subtrees whose maximum values can reach the next result.
+//
+// Without a MaxValueTable, siblings must be arranged in descending order of
+// their maximum values, as BasicTrie::MAX_VALUE_ORDER does. Then first
+// children lead to the maximum value of a subtree, and a path of first
+// children is expanded at once.
+//
+// A TopKCache built from the same trie answers its nodes without any
+// traversal when it has enough results.
+class TopKCompleter : public CompleterBase
+{
+public:
+	TopKCompleter() : trie_(NULL), max_values_(NULL), cache_(NULL), key_(),
+		value_(TrieBase::INVALID_VALUE), num_results_(0), max_num_results_(0),
+		result_id_(0), nodes_(), entries_(), children_(), path_indices_(),
+		path_values_(), path_max_values_() {}
+	~TopKCompleter() { clear(); }
+
+	bool start(const TrieBase &trie, UInt32 index);
+	bool start(const TrieBase &trie, UInt32 index, UInt32 max_num_results,
+		const TopKCache *cache = NULL);
+	// Any trie works with a MaxValueTable built from itself.
+	bool start(const TrieBase &trie, const MaxValueTable &max_values,
+		UInt32 index, UInt32 max_num_results, const TopKCache *cache = NULL);
+	bool next();
+
+	const char *key() const;
+	UInt32 length() const { return key_.size() - 1; }
+	UInt32 value() const { return value_; }
+
+	void clear();
+
+private:
+	const TrieBase *trie_;
+	const MaxValueTable *max_values_;
+	const TopKCache *cache_;
+	std::vector<char> key_;
+	UInt32 value_;
+	UInt32 num_results_;
+	UInt32 max_num_results_;
+	UInt32 result_id_;
+	std::vector<TopKCompleterNode> nodes_;
+	std::vector<TopKCompleterEntry> entries_;
+	std::vector<std::pair<UInt32, UInt32> > children_;
+	std::vector<UInt32> path_indices_;
+	std::vector<UInt32> path_values_;
+	std::vector<UInt32> path_max_values_;
+
+	// Disallows copies.
+	TopKCompleter(const TopKCompleter &);
+	TopKCompleter &operator=(const TopKCompleter &);
+
+	bool start_with_cache(const TopKCache *cache, UInt32 index);
+	bool next_in_cache();
+
+	void expand(UInt32 node_index, UInt32 max_value);
+	void expand_path(UInt32 node_index, UInt32 max_value);
+	void enqueue_node(UInt32 trie_index, UInt32 parent, UInt32 max_value);
+	void enqueue_sibling(UInt32 node_index);
+	UInt32 add_child(UInt32 node_index);
+	UInt32 add_sorted_child(UInt32 child_id, UInt32 parent);
+	UInt32 add_node(UInt32 trie_index, UInt32 parent);
+
+	void push_entry(UInt32 node_index, UInt32 value, bool is_key);
+	void restore_key(UInt32 node_index);
+};
+
+}  // namespace sumire
+
+#include "top-k-completer-in.h"
+
+#endif  // SUMIRE_TOP_K_COMPLETER_H
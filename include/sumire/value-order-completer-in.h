@@ -1,6 +1,9 @@
 #ifndef SUMIRE_VALUE_ORDER_COMPLETER_IN_H
 #define SUMIRE_VALUE_ORDER_COMPLETER_IN_H
 
+#include "var-int-reader.h"
+#include "var-int-writer.h"
+
 #include <algorithm>
 #include <cassert>
 
@@ -67,6 +70,156 @@ inline const char *ValueOrderCompleter::key() const
 	return &key_[0];
 }
 
+// Only the candidates, the queued nodes and their ancestors are saved, and
+// the other nodes are never referred to again. Nodes keep their relative
+// order, so the candidate queue is still a heap after renumbering.
+inline bool ValueOrderCompleter::save(std::ostream *output) const
+{
+	assert(trie_ != NULL);
+	assert(output != NULL);
+
+	std::vector<UInt32> ids(nodes_.size(), 0);
+	ids[0] = 1;
+	for (UInt32 i = 0; i < node_queue_.size() + candidate_queue_.size(); ++i)
+	{
+		UInt32 node_index = (i < node_queue_.size()) ? node_queue_[i] :
+			candidate_queue_[i - node_queue_.size()].index();
+		for ( ; ids[node_index] == 0;
+			node_index = nodes_[node_index].parent())
+			ids[node_index] = 1;
+	}
+
+	UInt32 num_nodes = 0;
+	for (UInt32 node_index = 0; node_index < ids.size(); ++node_index)
+	{
+		if (ids[node_index] != 0)
+			ids[node_index] = num_nodes++;
+	}
+
+	UInt32 key_length = key_.empty() ? 0 : length();
+
+	VarIntWriter writer(output);
+	if (!writer.write(value_) || !writer.write(key_length))
+		return false;
+	for (UInt32 i = 0; i < key_length; ++i)
+	{
+		if (!writer.write(static_cast<UInt8>(key_[i])))
+			return false;
+	}
+
+	if (!writer.write(num_nodes))
+		return false;
+	for (UInt32 node_index = 0; node_index < ids.size(); ++node_index)
+	{
+		if (node_index != 0 && ids[node_index] == 0)
+			continue;
+
+		const ValueOrderCompleterNode &node = nodes_[node_index];
+		UInt32 distance = ids[node_index] - ids[node.parent()];
+		if (!writer.write(node.trie_index()) ||
+			!writer.write((distance << 1) | (node.is_queued() ? 1 : 0)))
+			return false;
+	}
+
+	if (!writer.write(node_queue_.size()))
+		return false;
+	for (UInt32 i = 0; i < node_queue_.size(); ++i)
+	{
+		if (!writer.write(ids[node_queue_[i]]))
+			return false;
+	}
+
+	if (!writer.write(candidate_queue_.size()))
+		return false;
+	for (UInt32 i = 0; i < candidate_queue_.size(); ++i)
+	{
+		if (!writer.write(ids[candidate_queue_[i].index()]) ||
+			!writer.write(candidate_queue_[i].value()))
+			return false;
+	}
+
+	return true;
+}
+
+// A broken state is rejected as long as it does not point to nodes out of
+// the trie or out of the saved nodes.
+inline bool ValueOrderCompleter::resume(
+	const TrieBase &trie, std::istream *input)
+{
+	assert(input != NULL);
+
+	clear();
+
+	VarIntReader reader(input);
+	if (trie.num_units() == 0 || !reader.read(&value_))
+		return resume_failed();
+
+	UInt32 key_length;
+	if (!reader.read(&key_length))
+		return resume_failed();
+	for (UInt32 i = 0; i < key_length; ++i)
+	{
+		UInt32 label;
+		if (!reader.read(&label) || label == 0 || label > UInt8Limits::max())
+			return resume_failed();
+		key_.push_back(static_cast<char>(label));
+	}
+	key_.push_back('\0');
+
+	UInt32 num_nodes;
+	if (!reader.read(&num_nodes) || num_nodes == 0)
+		return resume_failed();
+	for (UInt32 node_index = 0; node_index < num_nodes; ++node_index)
+	{
+		UInt32 trie_index, unit;
+		if (!reader.read(&trie_index) || !reader.read(&unit))
+			return resume_failed();
+
+		UInt32 distance = unit >> 1;
+		if (trie_index >= trie.num_units() || distance > node_index ||
+			(distance == 0 && node_index != 0))
+			return resume_failed();
+
+		ValueOrderCompleterNode node;
+		node.set_trie_index(trie_index);
+		node.set_parent(node_index - distance);
+		node.set_label(trie.label(trie_index));
+		if ((unit & 1) != 0)
+			node.set_is_queued();
+		nodes_.push_back(node);
+	}
+
+	UInt32 num_queued_nodes;
+	if (!reader.read(&num_queued_nodes))
+		return resume_failed();
+	for (UInt32 i = 0; i < num_queued_nodes; ++i)
+	{
+		UInt32 node_index;
+		if (!reader.read(&node_index) || node_index >= num_nodes)
+			return resume_failed();
+		node_queue_.push_back(node_index);
+	}
+
+	UInt32 num_candidates;
+	if (!reader.read(&num_candidates))
+		return resume_failed();
+	for (UInt32 i = 0; i < num_candidates; ++i)
+	{
+		UInt32 node_index, value;
+		if (!reader.read(&node_index) || node_index >= num_nodes ||
+			!reader.read(&value))
+			return resume_failed();
+
+		ValueOrderCompleterCandidate candidate;
+		candidate.set_index(node_index);
+		candidate.set_value(value);
+		candidate_queue_.push_back(candidate);
+	}
+
+	trie_ = &trie;
+	return true;
+}
+
 inline void ValueOrderCompleter::clear()
 {
 	trie_ = NULL;
@@ -77,6 +230,12 @@ inline void ValueOrderCompleter::clear()
 	candidate_queue_.clear();
 }
 
+inline bool ValueOrderCompleter::resume_failed()
+{
+	clear();
+	return false;
+}
+
 inline UInt32 ValueOrderCompleter::find_sibling(UInt32 node_index)
 {
 	assert(node_index < nodes_.size());
@@ -0,0 +1,62 @@
+#ifndef SUMIRE_VAR_INT_READER_H
+#define SUMIRE_VAR_INT_READER_H
+
+#include "int-types.h"
+
+#include <cassert>
+#include <iostream>
+
+namespace sumire {
+
+class VarIntReader
+{
+public:
+	explicit VarIntReader(std::istream *input) : input_(input) {}
+
+	// Bytes come directly from the stream buffer. Fails if an integer does
+	// not fit in a UInt32.
+	bool read(UInt32 *value)
+	{
+		assert(value != NULL);
+
+		typedef std::char_traits<char> Traits;
+
+		std::streambuf *buf = input_->rdbuf();
+		if (buf == NULL)
+			return false;
+
+		UInt32 temp = 0;
+		for (UInt32 shift = 0; shift < 32; shift += 7)
+		{
+			Traits::int_type c = buf->sbumpc();
+			if (Traits::eq_int_type(c, Traits::eof()))
+			{
+				input_->setstate(std::ios::eofbit | std::ios::failbit);
+				return false;
+			}
+
+			UInt32 unit = static_cast<UInt8>(Traits::to_char_type(c));
+			if ((unit & 0x7F) > (UInt32Limits::max() >> shift))
+				return false;
+
+			temp |= (unit & 0x7F) << shift;
+			if ((unit & 0x80) == 0)
+			{
+				*value = temp;
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	std::istream *input_;
+
+	// Disallows copies.
+	VarIntReader(const VarIntReader &);
+	VarIntReader &operator=(const VarIntReader &);
+};
+
+}  // namespace sumire
+
+#endif  // SUMIRE_VAR_INT_READER_H
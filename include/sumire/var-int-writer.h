@@ -0,0 +1,52 @@
+#ifndef SUMIRE_VAR_INT_WRITER_H
+#define SUMIRE_VAR_INT_WRITER_H
+
+#include "int-types.h"
+
+#include <iostream>
+
+namespace sumire {
+
+// VarIntWriter writes an integer in 7-bit units from the lowest one, and
+// the highest bit of each byte tells whether another unit follows.
+class VarIntWriter
+{
+public:
+	explicit VarIntWriter(std::ostream *output) : output_(output) {}
+
+	// Bytes go directly to the stream buffer, because a state has many
+	// small integers.
+	bool write(UInt32 value)
+	{
+		std::streambuf *buf = output_->rdbuf();
+		while (value >= 0x80)
+		{
+			if (!put(buf, static_cast<char>((value & 0x7F) | 0x80)))
+				return false;
+			value >>= 7;
+		}
+		return put(buf, static_cast<char>(value));
+	}
+
+private:
+	std::ostream *output_;
+
+	bool put(std::streambuf *buf, char c)
+	{
+		typedef std::char_traits<char> Traits;
+		if (buf == NULL || Traits::eq_int_type(buf->sputc(c), Traits::eof()))
+		{
+			output_->setstate(std::ios::badbit);
+			return false;
+		}
+		return true;
+	}
+
+	// Disallows copies.
+	VarIntWriter(const VarIntWriter &);
+	VarIntWriter &operator=(const VarIntWriter &);
+};
+
+}  // namespace sumire
+
+#endif  // SUMIRE_VAR_INT_WRITER_H
@@ -1,6 +1,7 @@
 #ifndef SUMIRE_VIRTUAL_TRIE_IN_H
 #define SUMIRE_VIRTUAL_TRIE_IN_H
 
+#include "label-scanner.h"
 #include "object-io.h"
 
 #include <cassert>
@@ -13,13 +14,30 @@ inline VirtualTrie::VirtualTrie(const ObjectPool<BasicTrieUnit> &unit_pool,
 
 inline UInt32 VirtualTrie::find_child(UInt32 index, UInt8 child_label) const
 {
-	for (UInt32 child_index = child(index); child_index != 0;
-		child_index = sibling(child_index))
+	UInt32 child_index = child(index);
+	if (child_index == 0)
+		return 0;
+
+	// Units are contiguous only inside a block of the pools, so a run that
+	// crosses a block boundary is scanned block by block. Block sizes are
+	// powers of 2, and the smaller one gives boundaries of both pools.
+	UInt32 num_objs_per_block = unit_pool_->num_objs_per_block();
+	if (label_pool_->num_objs_per_block() < num_objs_per_block)
+		num_objs_per_block = label_pool_->num_objs_per_block();
+	const UInt32 mask = num_objs_per_block - 1;
+	for ( ; ; )
 	{
-		if (label(child_index) == child_label)
-			return child_index;
+		UInt32 num_units_in_block = mask + 1 - (child_index & mask);
+		if (num_units_in_block > num_units() - child_index)
+			num_units_in_block = num_units() - child_index;
+
+		UInt32 offset = LabelScanner::scan(&(*label_pool_)[child_index],
+			&(*unit_pool_)[child_index], num_units_in_block, child_label);
+		child_index += offset;
+		if (offset < num_units_in_block)
+			break;
 	}
-	return 0;
+	return ((*label_pool_)[child_index] == child_label) ? child_index : 0;
 }
 
 inline UInt32 VirtualTrie::child(UInt32 index) const
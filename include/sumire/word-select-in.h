@@ -0,0 +1,73 @@
+#ifndef SUMIRE_WORD_SELECT_IN_H
+#define SUMIRE_WORD_SELECT_IN_H
+
+#include <cassert>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif  // __BMI2__
+
+namespace sumire {
+
+inline UInt32 WordSelect::select_1(UInt32 unit, UInt32 count)
+{
+	assert(count > 0);
+	assert(count <= 32);
+
+#ifdef __BMI2__
+	return __builtin_ctz(_pdep_u32(1U << (count - 1), unit));
+#else  // __BMI2__
+	return select_1(static_cast<UInt64>(unit), count);
+#endif  // __BMI2__
+}
+
+inline UInt32 WordSelect::select_1(UInt64 unit, UInt32 count)
+{
+	assert(count > 0);
+	assert(count <= 64);
+
+#ifdef __BMI2__
+	return __builtin_ctzll(_pdep_u64(1ULL << (count - 1), unit));
+#else  // __BMI2__
+	const UInt64 ONES_STEP_8 = 0x0101010101010101ULL;
+	const UInt64 MSBS_STEP_8 = 0x8080808080808080ULL;
+
+	UInt64 rank = count - 1;
+
+	// Each byte of sums gets the number of 1s in the byte and lower bytes.
+	UInt64 sums = unit - ((unit & 0xAAAAAAAAAAAAAAAAULL) >> 1);
+	sums = (sums & 0x3333333333333333ULL)
+		+ ((sums >> 2) & 0x3333333333333333ULL);
+	sums = ((sums + (sums >> 4)) & 0x0F0F0F0F0F0F0F0FULL) * ONES_STEP_8;
+
+	// The MSB of each byte is set if the byte and lower bytes have at most
+	// rank 1s, so the number of such bytes gives the target byte.
+	UInt64 flags = (((rank * ONES_STEP_8) | MSBS_STEP_8) - sums) & MSBS_STEP_8;
+	UInt32 shift = static_cast<UInt32>(
+		(((flags >> 7) * ONES_STEP_8) >> 56) * 8);
+	rank -= ((sums << 8) >> shift) & 0xFF;
+
+	// The same is done in the target byte, whose bits are spread to bytes.
+	UInt64 bits = (((unit >> shift) & 0xFF) * ONES_STEP_8)
+		& 0x8040201008040201ULL;
+	bits = ((bits + 0x7F7F7F7F7F7F7F7FULL) & MSBS_STEP_8) >> 7;
+	sums = bits * ONES_STEP_8;
+
+	flags = (((rank * ONES_STEP_8) | MSBS_STEP_8) - sums) & MSBS_STEP_8;
+	return shift + static_cast<UInt32>(((flags >> 7) * ONES_STEP_8) >> 56);
+#endif  // __BMI2__
+}
+
+inline UInt32 WordSelect::select_0(UInt32 unit, UInt32 count)
+{
+	return select_1(~unit, count);
+}
+
+inline UInt32 WordSelect::select_0(UInt64 unit, UInt32 count)
+{
+	return select_1(~unit, count);
+}
+
+}  // namespace sumire
+
+#endif  // SUMIRE_WORD_SELECT_IN_H
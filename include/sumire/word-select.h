@@ -0,0 +1,34 @@
+#ifndef SUMIRE_WORD_SELECT_H
+#define SUMIRE_WORD_SELECT_H
+
+#include "int-types.h"
+
+namespace sumire {
+
+// WordSelect finds the position of the count-th 1 (or 0) in a word, where
+// count starts from 1. PDEP is used if BMI2 is enabled at compile time,
+// otherwise broadword operations are used instead of lookup tables.
+class WordSelect
+{
+public:
+	static UInt32 select_1(UInt32 unit, UInt32 count);
+	static UInt32 select_1(UInt64 unit, UInt32 count);
+
+	static UInt32 select_0(UInt32 unit, UInt32 count);
+	static UInt32 select_0(UInt64 unit, UInt32 count);
+
+private:
+	// Disallows instantiation.
+	WordSelect() {}
+	~WordSelect() {}
+
+	// Disallows copies.
+	WordSelect(const WordSelect &);
+	WordSelect &operator=(const WordSelect &);
+};
+
+}  // namespace sumire
+
+#include "word-select-in.h"
+
+#endif  // SUMIRE_WORD_SELECT_H
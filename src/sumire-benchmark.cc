@@ -7,6 +7,8 @@
 #include <sumire/succinct-trie.h>
 #include <sumire/louds-trie.h>
 #include <sumire/louds-plus-trie.h>
+#include <sumire/patricia-trie.h>
+#include <sumire/hybrid-trie.h>
 #include <sumire/basic-completer.h>
 #include <sumire/value-order-completer.h>
 
@@ -223,6 +225,8 @@ void trie_benchmark(const sumire::TrieBase &src_trie,
 	TRIE_BENCHMARK(sumire::SuccinctTrie<sumire::BasicSuccinctBitVector>);
 	TRIE_BENCHMARK(sumire::LoudsTrie<sumire::BasicSuccinctBitVector>);
 	TRIE_BENCHMARK(sumire::LoudsPlusTrie<sumire::BasicSuccinctBitVector>);
+	TRIE_BENCHMARK(sumire::PatriciaTrie<sumire::BasicSuccinctBitVector>);
+	TRIE_BENCHMARK(sumire::HybridTrie<sumire::BasicSuccinctBitVector>);
 	TRIE_BENCHMARK(sumire::SuccinctTrie<sumire::SimplifiedSuccinctBitVector>);
 	TRIE_BENCHMARK(sumire::LoudsTrie<sumire::SimplifiedSuccinctBitVector>);
 	TRIE_BENCHMARK(sumire::LoudsPlusTrie<sumire::SimplifiedSuccinctBitVector>);
@@ -0,0 +1,339 @@
+#include <sumire/basic-succinct-bit-vector.h>
+#include <sumire/hybrid-succinct-bit-vector.h>
+#include <sumire/simplified-succinct-bit-vector.h>
+#include <sumire/pop-count.h>
+#include <sumire/select-table.h>
+#include <sumire/word-select.h>
+
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const sumire::UInt32 NUM_QUERIES = 1 << 20;
+
+// Bit vectors range from L1-resident sizes to sizes beyond the LLC.
+const sumire::UInt32 NUM_BITS_LIST[] = { 1 << 16, 1 << 20, 1 << 24, 1 << 28 };
+const sumire::UInt32 DENSITY_LIST[] = { 1, 10, 50, 90, 99 };
+
+enum AccessPattern
+{
+	RANDOM_ACCESS,
+	SEQUENTIAL_ACCESS,
+	CLUSTERED_ACCESS,
+	NUM_ACCESS_PATTERNS
+};
+
+const char * const ACCESS_PATTERN_NAMES[] = {
+	"random", "sequential", "clustered"
+};
+
+// Clustered queries fall in windows of CLUSTER_WIDTH at random positions.
+const sumire::UInt32 CLUSTER_SIZE = 64;
+const sumire::UInt32 CLUSTER_WIDTH = 1 << 12;
+
+class TimeWatch
+{
+public:
+	TimeWatch() : cl_(std::clock()) {}
+
+	double elapsed() const
+	{ return 1.0 * (std::clock() - cl_) / CLOCKS_PER_SEC; }
+
+private:
+	std::clock_t cl_;
+
+	// Disallows copies.
+	TimeWatch(const TimeWatch &);
+	TimeWatch &operator=(const TimeWatch &);
+};
+
+// Xorshift is used because std::rand() is too slow to fill large bit
+// vectors and may have only 15 random bits.
+class RandomNumberGenerator
+{
+public:
+	RandomNumberGenerator() : x_(123456789), y_(362436069),
+		z_(521288629), w_(88675123) {}
+
+	sumire::UInt32 operator()()
+	{
+		sumire::UInt32 t = x_ ^ (x_ << 11);
+		x_ = y_;
+		y_ = z_;
+		z_ = w_;
+		w_ = (w_ ^ (w_ >> 19)) ^ (t ^ (t >> 8));
+		return w_;
+	}
+
+private:
+	sumire::UInt32 x_;
+	sumire::UInt32 y_;
+	sumire::UInt32 z_;
+	sumire::UInt32 w_;
+
+	// Copyable.
+};
+
+double to_ns_per_op(double elapsed)
+{
+	return elapsed * 1000000000.0 / NUM_QUERIES;
+}
+
+// This function is the in-word part of selects before WordSelect, which
+// narrows down to a byte with byte sums and then looks up SelectTable.
+sumire::UInt32 table_select_1(sumire::UInt32 unit, sumire::UInt32 count)
+{
+	sumire::UInt32 bytes = unit;
+	bytes = ((bytes & 0xAAAAAAAA) >> 1) + (bytes & 0x55555555);
+	bytes = ((bytes & 0xCCCCCCCC) >> 2) + (bytes & 0x33333333);
+	bytes = ((bytes >> 4) + bytes) & 0x0F0F0F0F;
+	bytes += bytes << 8;
+	bytes += bytes << 16;
+
+	sumire::UInt32 index = 0;
+	sumire::UInt64 offset = 0;
+	if (count <= ((bytes << 16) >> 24))
+		offset += 16;
+	if (count <= ((bytes << (offset + 8)) >> 24))
+		offset += 8;
+
+	count -= ((bytes << offset) << 8) >> 24;
+	unit >>= 32 - (offset + 8);
+	index += 32 - (offset + 8);
+
+	index += sumire::SelectTable::lookup(true, count,
+		static_cast<sumire::UInt8>(unit));
+
+	return index - 1;
+}
+
+void make_select_queries(std::vector<sumire::UInt32> *units,
+	std::vector<sumire::UInt32> *counts)
+{
+	RandomNumberGenerator gen;
+
+	units->resize(NUM_QUERIES);
+	counts->resize(NUM_QUERIES);
+	for (sumire::UInt32 i = 0; i < NUM_QUERIES; ++i)
+	{
+		sumire::UInt32 unit;
+		do
+		{
+			unit = gen();
+		} while (unit == 0);
+
+		(*units)[i] = unit;
+		(*counts)[i] = (gen() % sumire::PopCount::count(unit)) + 1;
+	}
+}
+
+void word_select_benchmark()
+{
+	std::vector<sumire::UInt32> units, counts;
+	make_select_queries(&units, &counts);
+
+	sumire::UInt32 table_total = 0;
+	double table_elapsed;
+	{
+		TimeWatch watch;
+		for (sumire::UInt32 i = 0; i < NUM_QUERIES; ++i)
+			table_total += table_select_1(units[i], counts[i]);
+		table_elapsed = watch.elapsed();
+	}
+
+	sumire::UInt32 word_total = 0;
+	double word_elapsed;
+	{
+		TimeWatch watch;
+		for (sumire::UInt32 i = 0; i < NUM_QUERIES; ++i)
+			word_total += sumire::WordSelect::select_1(units[i], counts[i]);
+		word_elapsed = watch.elapsed();
+	}
+
+	if (table_total != word_total)
+		std::cerr << "error: results differ" << std::endl;
+
+	std::cout << "SelectTable (ns/op): "
+		<< to_ns_per_op(table_elapsed) << std::endl;
+	std::cout << "WordSelect (ns/op): "
+		<< to_ns_per_op(word_elapsed) << std::endl;
+}
+
+void make_units(sumire::UInt32 num_bits, sumire::UInt32 density,
+	std::vector<sumire::UInt32> *units)
+{
+	RandomNumberGenerator gen;
+
+	const sumire::UInt32 threshold = static_cast<sumire::UInt32>(
+		(static_cast<sumire::UInt64>(1) << 32) * density / 100);
+
+	units->assign(num_bits / 32, 0);
+	for (sumire::UInt32 i = 0; i < num_bits; ++i)
+	{
+		if (gen() < threshold)
+			(*units)[i / 32] |= 1U << (i % 32);
+	}
+}
+
+// This function generates NUM_QUERIES values in [first, first + range).
+void make_queries(AccessPattern pattern, sumire::UInt32 first,
+	sumire::UInt32 range, std::vector<sumire::UInt32> *queries)
+{
+	RandomNumberGenerator gen;
+
+	queries->resize(NUM_QUERIES);
+	switch (pattern)
+	{
+	case RANDOM_ACCESS:
+		for (sumire::UInt32 i = 0; i < NUM_QUERIES; ++i)
+			(*queries)[i] = first + (gen() % range);
+		break;
+	case SEQUENTIAL_ACCESS:
+		{
+			sumire::UInt32 step = (range > NUM_QUERIES) ?
+				(range / NUM_QUERIES) : 1;
+			for (sumire::UInt32 i = 0; i < NUM_QUERIES; ++i)
+				(*queries)[i] = first
+					+ static_cast<sumire::UInt32>(
+					(static_cast<sumire::UInt64>(i) * step) % range);
+		}
+		break;
+	case CLUSTERED_ACCESS:
+		{
+			sumire::UInt32 width = (range < CLUSTER_WIDTH) ?
+				range : CLUSTER_WIDTH;
+			sumire::UInt32 base = 0;
+			for (sumire::UInt32 i = 0; i < NUM_QUERIES; ++i)
+			{
+				if (i % CLUSTER_SIZE == 0)
+					base = gen() % (range - width + 1);
+				(*queries)[i] = first + base + (gen() % width);
+			}
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+// Query types are given as template arguments so that queries are inlined.
+#define SBV_QUERY(name, expr) \
+	class name \
+	{ \
+	public: \
+		template <typename SUCCINCT_BIT_VECTOR_TYPE> \
+		static sumire::UInt32 query(const SUCCINCT_BIT_VECTOR_TYPE &sbv, \
+			sumire::UInt32 x) { return (expr); } \
+	};
+
+SBV_QUERY(Rank0Query, sbv.rank_0(x))
+SBV_QUERY(Rank1Query, sbv.rank_1(x))
+SBV_QUERY(Select0Query, sbv.select_0(x))
+SBV_QUERY(Select1Query, sbv.select_1(x))
+SBV_QUERY(GetQuery, sbv.get(x) ? 1 : 0)
+
+#undef SBV_QUERY
+
+template <typename QUERY_TYPE, typename SUCCINCT_BIT_VECTOR_TYPE>
+double time_queries(const SUCCINCT_BIT_VECTOR_TYPE &sbv,
+	const std::vector<sumire::UInt32> &queries, sumire::UInt32 *total)
+{
+	TimeWatch watch;
+	for (sumire::UInt32 i = 0; i < NUM_QUERIES; ++i)
+		*total += QUERY_TYPE::query(sbv, queries[i]);
+	return to_ns_per_op(watch.elapsed());
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+void sbv_benchmark(const char *sbv_type_name,
+	const std::vector<sumire::UInt32> &units, sumire::UInt32 num_bits)
+{
+	SUCCINCT_BIT_VECTOR_TYPE sbv;
+	sbv.build(&units[0], num_bits);
+
+	std::cout << sbv_type_name << ": size (bytes): " << sbv.size()
+		<< ", overhead (%): " << std::setprecision(3)
+		<< ((100.0 * sbv.size() / (num_bits / 8)) - 100.0) << std::endl;
+
+	std::cout << std::setw(12) << "(ns/op)" << std::setw(10) << "rank_0"
+		<< std::setw(10) << "rank_1" << std::setw(10) << "select_0"
+		<< std::setw(10) << "select_1" << std::setw(10) << "get"
+		<< std::endl;
+
+	sumire::UInt32 total = 0;
+	std::vector<sumire::UInt32> indices, zero_counts, one_counts;
+	for (int pattern = 0; pattern < NUM_ACCESS_PATTERNS; ++pattern)
+	{
+		AccessPattern access_pattern = static_cast<AccessPattern>(pattern);
+		make_queries(access_pattern, 0, num_bits, &indices);
+		make_queries(access_pattern, 1, sbv.num_zeros(), &zero_counts);
+		make_queries(access_pattern, 1, sbv.num_ones(), &one_counts);
+
+		std::cout << std::setw(12) << ACCESS_PATTERN_NAMES[pattern];
+		std::cout << std::setw(10)
+			<< time_queries<Rank0Query>(sbv, indices, &total);
+		std::cout << std::setw(10)
+			<< time_queries<Rank1Query>(sbv, indices, &total);
+		std::cout << std::setw(10)
+			<< time_queries<Select0Query>(sbv, zero_counts, &total);
+		std::cout << std::setw(10)
+			<< time_queries<Select1Query>(sbv, one_counts, &total);
+		std::cout << std::setw(10)
+			<< time_queries<GetQuery>(sbv, indices, &total);
+		std::cout << std::endl;
+	}
+
+	// The total is printed so that queries are not optimized away.
+	std::cout << "#total: " << total << std::endl;
+}
+
+void sbv_benchmark(sumire::UInt32 num_bits, sumire::UInt32 density)
+{
+	std::vector<sumire::UInt32> units;
+	make_units(num_bits, density, &units);
+
+	std::cout << "\n==> #bits: " << num_bits << ", density (%): "
+		<< density << " <==" << std::endl;
+
+#define SBV_BENCHMARK(sbv_type) \
+	sbv_benchmark<sbv_type>(#sbv_type, units, num_bits)
+
+	SBV_BENCHMARK(sumire::BasicSuccinctBitVector);
+	SBV_BENCHMARK(sumire::SimplifiedSuccinctBitVector);
+	SBV_BENCHMARK(sumire::HybridSuccinctBitVector);
+
+#undef SBV_BENCHMARK
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	// The maximum number of bits can be given to skip large bit vectors.
+	sumire::UInt32 max_num_bits = sumire::UInt32Limits::max();
+	if (argc > 1)
+		max_num_bits = static_cast<sumire::UInt32>(
+			std::strtoul(argv[1], NULL, 10));
+
+	std::cout << "==> benchmark for in-word selects <==" << std::endl;
+
+	word_select_benchmark();
+
+	const std::size_t num_sizes =
+		sizeof(NUM_BITS_LIST) / sizeof(NUM_BITS_LIST[0]);
+	const std::size_t num_densities =
+		sizeof(DENSITY_LIST) / sizeof(DENSITY_LIST[0]);
+	for (std::size_t i = 0; i < num_sizes; ++i)
+	{
+		if (NUM_BITS_LIST[i] > max_num_bits)
+			break;
+		for (std::size_t j = 0; j < num_densities; ++j)
+			sbv_benchmark(NUM_BITS_LIST[i], DENSITY_LIST[j]);
+	}
+
+	return 0;
+}
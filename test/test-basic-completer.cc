@@ -3,8 +3,10 @@
 #include <sumire/ternary-trie.h>
 #include <sumire/da-trie.h>
 #include <sumire/succinct-trie.h>
+#include <sumire/hybrid-trie.h>
 #include <sumire/louds-plus-trie.h>
 #include <sumire/louds-trie.h>
+#include <sumire/patricia-trie.h>
 #include <sumire/basic-completer.h>
 
 #include "test-tools.h"
@@ -27,6 +29,7 @@ void test_completer(const TRIE_TYPE &trie, const test::Tools::KeysMap &keys)
 		++key_it;
 	}
 	assert(key_it == keys.end());
+	assert(completer.next() == false);
 }
 
 template <typename TRIE_TYPE>
@@ -39,6 +42,7 @@ void test_trie(const sumire::TrieBase &basic_trie,
 	FIND_ALL_KEYS(trie, keys);
 
 	test_completer(trie, keys);
+	test::Tools::test_resume<sumire::BasicCompleter>(trie);
 }
 
 }  // namespace
@@ -57,6 +61,8 @@ int main()
 	test_trie<sumire::SuccinctTrie<> >(trie, keys);
 	test_trie<sumire::LoudsTrie<> >(trie, keys);
 	test_trie<sumire::LoudsPlusTrie<> >(trie, keys);
+	test_trie<sumire::PatriciaTrie<> >(trie, keys);
+	test_trie<sumire::HybridTrie<> >(trie, keys);
 
 	return 0;
 }
@@ -2,8 +2,11 @@
 #include <sumire/hybrid-succinct-bit-vector.h>
 #include <sumire/simplified-succinct-bit-vector.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <sstream>
+#include <vector>
 
 #define CHECK_VALUES(sbv) \
 	for (sumire::UInt32 i = 0; i < TEST_SIZE; ++i) \
@@ -37,6 +40,163 @@ void make_sbv(SUCCINCT_BIT_VECTOR_TYPE *sbv)
 	CHECK_VALUES(*sbv)
 }
 
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+void make_sbv_from_units(SUCCINCT_BIT_VECTOR_TYPE *sbv)
+{
+	sumire::ObjectArray<sumire::UInt32> units;
+	units.resize((TEST_SIZE + 31) / 32);
+	for (sumire::UInt32 unit_id = 0; unit_id < units.num_objs(); ++unit_id)
+		units[unit_id] = 0xAAAAAAAA;
+
+	sbv->build(units.begin(), TEST_SIZE);
+
+	assert(sbv->num_bits() == TEST_SIZE);
+	assert(sbv->num_ones() == TEST_SIZE / 2);
+
+	CHECK_VALUES(*sbv)
+
+	sbv->build(&units, TEST_SIZE);
+
+	assert(units.num_objs() == 0);
+	assert(sbv->num_bits() == TEST_SIZE);
+	assert(sbv->num_ones() == TEST_SIZE / 2);
+
+	CHECK_VALUES(*sbv)
+}
+
+// Runs of 1s are compared with a naive scan.
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+void check_run_lengths(const SUCCINCT_BIT_VECTOR_TYPE &sbv)
+{
+	// Runs of 1s are measured from the end.
+	sumire::UInt32 run_length = 0;
+	for (sumire::UInt32 i = sbv.num_bits(); i > 0; --i)
+	{
+		run_length = sbv[i - 1] ? (run_length + 1) : 0;
+		assert(sbv.run_length_1(i - 1) == run_length);
+	}
+}
+
+// Random units with more blocks than MIN_PARALLEL_NUM_BLOCKS, so that
+// ranks are built in parallel if OpenMP is enabled, are compared with a
+// naive scan.
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+void check_random_units(const SUCCINCT_BIT_VECTOR_TYPE &sbv,
+	const std::vector<sumire::UInt32> &units, sumire::UInt32 num_bits)
+{
+	assert(sbv.num_bits() == num_bits);
+
+	sumire::UInt32 num_ones = 0;
+	for (sumire::UInt32 i = 0; i < num_bits; ++i)
+	{
+		bool bit = ((units[i / 32] >> (i % 32)) & 1) != 0;
+		assert(sbv[i] == bit);
+		if (bit)
+		{
+			++num_ones;
+			assert(sbv.select_1(num_ones) == i);
+		}
+		else
+			assert(sbv.select_0(i + 1 - num_ones) == i);
+		assert(sbv.rank_1(i) == num_ones);
+		assert(sbv.rank_0(i) == i + 1 - num_ones);
+	}
+	assert(sbv.num_ones() == num_ones);
+
+	check_run_lengths(sbv);
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+void test_random_units()
+{
+	const sumire::UInt32 NUM_BITS = (1 << 21) + 100;
+
+	std::srand(1);
+	std::vector<sumire::UInt32> units((NUM_BITS + 31) / 32);
+	for (std::size_t unit_id = 0; unit_id < units.size(); ++unit_id)
+	{
+		units[unit_id] = (static_cast<sumire::UInt32>(std::rand()) << 16) ^
+			static_cast<sumire::UInt32>(std::rand());
+	}
+	// Bits after the end must be ignored.
+	units.back() |= ~((1U << (NUM_BITS % 32)) - 1);
+
+	SUCCINCT_BIT_VECTOR_TYPE sbv;
+	sbv.build(&units[0], NUM_BITS);
+	check_random_units(sbv, units, NUM_BITS);
+
+	sumire::ObjectArray<sumire::UInt32> unit_array;
+	unit_array.resize(static_cast<sumire::UInt32>(units.size()));
+	std::copy(units.begin(), units.end(), unit_array.begin());
+
+	sbv.build(&unit_array, NUM_BITS);
+	assert(unit_array.num_objs() == 0);
+	check_random_units(sbv, units, NUM_BITS);
+}
+
+template <typename SUCCINCT_BIT_VECTOR_TYPE>
+void test_batch()
+{
+	// Long runs of 0s and 1s make batch selects skip many blocks.
+	sumire::BitVector bv;
+	std::srand(0);
+	while (bv.num_bits() < TEST_SIZE)
+	{
+		if (std::rand() % 8 == 0)
+			bv.append_run((std::rand() % 2) != 0, std::rand() % 4096);
+		else
+			bv.append_bits(std::rand(), std::rand() % 32);
+	}
+
+	SUCCINCT_BIT_VECTOR_TYPE sbv;
+	sbv.build(bv);
+
+	// Answers are compared with a naive scan of the bits.
+	std::vector<sumire::UInt32> ranks, one_positions, zero_positions;
+	for (sumire::UInt32 i = 0; i < bv.num_bits(); ++i)
+	{
+		if (bv[i])
+			one_positions.push_back(i);
+		else
+			zero_positions.push_back(i);
+		ranks.push_back(static_cast<sumire::UInt32>(one_positions.size()));
+	}
+	assert(sbv.num_ones() == one_positions.size());
+
+	std::vector<sumire::UInt32> indices, results;
+	for (sumire::UInt32 i = 0; i < sbv.num_bits(); i += std::rand() % 100)
+		indices.push_back(i);
+	results.resize(indices.size());
+
+	sbv.rank_1(&indices[0], indices.size(), &results[0]);
+	for (std::size_t i = 0; i < indices.size(); ++i)
+		assert(results[i] == ranks[indices[i]]);
+
+	sbv.rank_0(&indices[0], indices.size(), &results[0]);
+	for (std::size_t i = 0; i < indices.size(); ++i)
+		assert(results[i] == indices[i] + 1 - ranks[indices[i]]);
+
+	std::vector<sumire::UInt32> counts;
+	for (sumire::UInt32 i = 1; i <= sbv.num_ones(); i += std::rand() % 100)
+		counts.push_back(i);
+	results.resize(counts.size());
+
+	sbv.select_1(&counts[0], counts.size(), &results[0]);
+	for (std::size_t i = 0; i < counts.size(); ++i)
+		assert(results[i] == one_positions[counts[i] - 1]);
+
+	counts.clear();
+	for (sumire::UInt32 i = 1; i <= sbv.num_zeros(); i += std::rand() % 100)
+		counts.push_back(i);
+	results.resize(counts.size());
+
+	sbv.select_0(&counts[0], counts.size(), &results[0]);
+	for (std::size_t i = 0; i < counts.size(); ++i)
+		assert(results[i] == zero_positions[counts[i] - 1]);
+
+	check_run_lengths(sbv);
+}
+
 template <typename SUCCINCT_BIT_VECTOR_TYPE>
 void test_io(const SUCCINCT_BIT_VECTOR_TYPE &sbv)
 {
@@ -75,9 +235,13 @@ void test_sbv(const char *type_name)
 
 	SUCCINCT_BIT_VECTOR_TYPE sbv;
 
+	make_sbv_from_units(&sbv);
 	make_sbv(&sbv);
 	test_io(sbv);
 	clear_sbv(&sbv);
+
+	test_random_units<SUCCINCT_BIT_VECTOR_TYPE>();
+	test_batch<SUCCINCT_BIT_VECTOR_TYPE>();
 }
 
 }  // namespace
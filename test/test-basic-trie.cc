@@ -13,6 +13,8 @@ void build_trie(const test::Tools::KeysMap &keys, sumire::BasicTrie *trie)
 
 	assert(builder.finish() == true);
 
+	test::Tools::test_find_child(builder.virtual_trie());
+
 	std::stringstream stream;
 	assert(builder.virtual_trie().write(&stream) == true);
 
@@ -57,6 +59,50 @@ void convert_trie(const test::Tools::KeysMap &keys,
 	assert(trie.num_keys() == keys.size());
 
 	FIND_ALL_KEYS(trie, keys)
+
+	assert(trie.build(src_trie, sumire::BasicTrie::VEB_ORDER) == true);
+
+	assert(trie.num_units() == src_trie.num_units());
+	assert(trie.num_keys() == keys.size());
+
+	FIND_ALL_KEYS(trie, keys)
+
+	test::Tools::test_find_child(trie);
+
+	// The last key is the most frequent query, and every 8th key and some
+	// missing keys are also queried.
+	std::vector<const char *> queries;
+	std::string hot_key = keys.rbegin()->first;
+	queries.assign(1000, hot_key.c_str());
+	sumire::UInt32 key_id = 0;
+	for (test::Tools::KeysIterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		if (key_id++ % 8 == 0)
+			queries.push_back(it->first.c_str());
+	}
+	queries.push_back("");
+	queries.push_back("0123");
+
+	assert(trie.build(src_trie, &queries[0],
+		static_cast<sumire::UInt32>(queries.size())) == true);
+
+	assert(trie.num_units() == src_trie.num_units());
+	assert(trie.num_keys() == keys.size());
+
+	FIND_ALL_KEYS(trie, keys)
+
+	sumire::UInt32 index = trie.root();
+	for (std::size_t i = 0; i < hot_key.length(); ++i)
+	{
+		index = trie.child(index);
+		assert(trie.label(index) == static_cast<sumire::UInt8>(hot_key[i]));
+	}
+
+	assert(trie.build(src_trie, NULL, 0) == true);
+
+	assert(trie.num_units() == src_trie.num_units());
+
+	FIND_ALL_KEYS(trie, keys)
 }
 
 }  // namespace
@@ -71,6 +117,8 @@ int main()
 	build_trie(keys, &trie);
 	convert_trie(keys, trie);
 
+	test::Tools::test_find_child(trie);
+
 	test::Tools::test_reload(trie, keys);
 	test::Tools::test_map(trie, keys);
 	test::Tools::test_clear(&trie);
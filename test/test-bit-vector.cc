@@ -27,23 +27,123 @@ void make_bv(sumire::BitVector *bv)
 	CHECK_VALUES(*bv)
 }
 
+void append_bv(sumire::BitVector *bv)
+{
+	// Appends the same pattern as make_bv() with various widths.
+	sumire::UInt32 num_bits = 0;
+	for (sumire::UInt32 count = 0; num_bits < TEST_SIZE; ++count)
+	{
+		sumire::UInt32 width = count % 65;
+		if (width > TEST_SIZE - num_bits)
+			width = TEST_SIZE - num_bits;
+
+		sumire::UInt64 bits = ~static_cast<sumire::UInt64>(0) / 3;
+		if (num_bits % 2 == 0)
+			bits <<= 1;
+		bv->append_bits(bits, width);
+		num_bits += width;
+
+		assert(bv->num_bits() == num_bits);
+	}
+
+	CHECK_VALUES(*bv)
+}
+
+void append_runs(sumire::BitVector *bv)
+{
+	sumire::UInt32 num_bits = 0;
+	for (sumire::UInt32 count = 0; count < 256; ++count)
+	{
+		bv->append_run((count & 1) != 0, count);
+		num_bits += count;
+
+		assert(bv->num_bits() == num_bits);
+	}
+
+	sumire::UInt32 index = 0;
+	for (sumire::UInt32 count = 0; count < 256; ++count)
+	{
+		for (sumire::UInt32 i = 0; i < count; ++i)
+			assert((*bv)[index++] == ((count & 1) != 0));
+	}
+
+	bv->clear();
+	for (sumire::UInt32 value = 0; value < 100; ++value)
+		bv->append_unary(value);
+
+	index = 0;
+	for (sumire::UInt32 value = 0; value < 100; ++value)
+	{
+		for (sumire::UInt32 i = 0; i < value; ++i)
+			assert((*bv)[index++] == true);
+		assert((*bv)[index++] == false);
+	}
+	assert(bv->num_bits() == index);
+
+	bv->resize(10);
+	assert(bv->num_bits() == 10);
+	bv->resize(100, true);
+	assert(bv->num_bits() == 100);
+	for (sumire::UInt32 i = 10; i < 100; ++i)
+		assert((*bv)[i] == true);
+
+	bv->clear();
+}
+
 void test_io(const sumire::BitVector &bv)
 {
 	std::stringstream stream;
 
 	assert(bv.write(&stream) == true);
 
+	// Pooled and contiguous bit vectors share the same format.
 	sumire::BitVector reloaded_bv;
 	assert(reloaded_bv.read(&stream) == true);
 
 	CHECK_VALUES(reloaded_bv)
 
+	stream.seekg(0);
+
+	sumire::BitVector contiguous_bv(sumire::BitVector::CONTIGUOUS_STORAGE);
+	assert(contiguous_bv.read(&stream) == true);
+
+	CHECK_VALUES(contiguous_bv)
+
 	std::string written_bv = stream.str();
 
 	sumire::BitVector mapped_bv;
 	mapped_bv.map(&written_bv[0]);
 
 	CHECK_VALUES(mapped_bv)
+
+	sumire::BitVector mapped_contiguous_bv(
+		sumire::BitVector::CONTIGUOUS_STORAGE);
+	mapped_contiguous_bv.map(&written_bv[0]);
+
+	CHECK_VALUES(mapped_contiguous_bv)
+}
+
+void test_release(sumire::BitVector *bv)
+{
+	assert(bv->is_contiguous());
+
+	const sumire::UInt32 num_units = bv->num_units();
+	for (sumire::UInt32 unit_id = 0; unit_id < num_units; ++unit_id)
+		assert(bv->units()[unit_id] == bv->unit(unit_id));
+
+	sumire::ObjectArray<sumire::UInt32> units;
+	bv->release(&units);
+
+	assert(units.num_objs() == num_units);
+	for (sumire::UInt32 i = 0; i < TEST_SIZE; ++i)
+	{
+		bool bit = (units[i / sumire::BitVector::BITS_PER_UNIT]
+			>> (i % sumire::BitVector::BITS_PER_UNIT)) & 1;
+		assert(bit == to_flag(i));
+	}
+
+	assert(bv->num_units() == 0);
+	assert(bv->num_bits() == 0);
 }
 
 void clear_bv(sumire::BitVector *bv)
@@ -66,5 +166,24 @@ int main()
 	test_io(bv);
 	clear_bv(&bv);
 
+	append_bv(&bv);
+	test_io(bv);
+	clear_bv(&bv);
+
+	append_runs(&bv);
+
+	sumire::BitVector contiguous_bv(sumire::BitVector::CONTIGUOUS_STORAGE);
+
+	make_bv(&contiguous_bv);
+	test_io(contiguous_bv);
+	clear_bv(&contiguous_bv);
+
+	contiguous_bv.reserve(TEST_SIZE);
+	append_bv(&contiguous_bv);
+	test_io(contiguous_bv);
+	test_release(&contiguous_bv);
+
+	append_runs(&contiguous_bv);
+
 	return 0;
 }
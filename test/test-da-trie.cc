@@ -4,6 +4,45 @@
 
 #include "test-tools.h"
 
+namespace {
+
+void convert_trie(const test::Tools::KeysMap &keys,
+	const sumire::DaTrie &src_trie)
+{
+	sumire::DaTrie trie;
+
+	// Random keys have no children, so their leaves are all inline.
+	assert(trie.build(src_trie, sumire::DaTrie::INLINE_LEAF_LAYOUT) == true);
+
+	assert(trie.num_nodes() == src_trie.num_nodes());
+	assert(trie.num_units() < src_trie.num_units() - (keys.size() / 2));
+
+	FIND_ALL_KEYS(trie, keys)
+
+	// The unit of an inline leaf keeps a value instead of an offset, and
+	// find_child() must not follow it.
+	for (test::Tools::KeysIterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		sumire::UInt32 index = trie.root();
+		for (std::size_t i = 0; i < it->first.length(); ++i)
+		{
+			index = trie.find_child(index,
+				static_cast<sumire::UInt8>(it->first[i]));
+		}
+		for (int label = 1; label < 256; ++label)
+		{
+			assert(trie.find_child(index,
+				static_cast<sumire::UInt8>(label)) == 0);
+		}
+	}
+
+	test::Tools::test_find_child(trie);
+	test::Tools::test_reload(trie, keys);
+	test::Tools::test_map(trie, keys);
+}
+
+}  // namespace
+
 int main()
 {
 	test::Tools::KeysMap keys;
@@ -11,6 +50,9 @@ int main()
 
 	sumire::DaTrie trie;
 	test::Tools::build_trie(keys, &trie);
+	test::Tools::test_find_child(trie);
+
+	convert_trie(keys, trie);
 
 	test::Tools::test_reload(trie, keys);
 	test::Tools::test_map(trie, keys);
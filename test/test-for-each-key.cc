@@ -0,0 +1,110 @@
+#include <sumire/trie-builder.h>
+#include <sumire/basic-trie.h>
+#include <sumire/ternary-trie.h>
+#include <sumire/da-trie.h>
+#include <sumire/succinct-trie.h>
+#include <sumire/hybrid-trie.h>
+#include <sumire/louds-plus-trie.h>
+#include <sumire/louds-trie.h>
+#include <sumire/patricia-trie.h>
+#include <sumire/for-each-key.h>
+
+#include <cstring>
+
+#include "test-tools.h"
+
+namespace {
+
+class KeyCollector
+{
+public:
+	explicit KeyCollector(std::size_t max_num_keys = 0)
+		: keys_(), max_num_keys_(max_num_keys) {}
+
+	bool operator()(const char *key, sumire::UInt32 length,
+		sumire::UInt32 value)
+	{
+		assert(std::strlen(key) == length);
+
+		keys_.insert(std::make_pair(std::string(key, length), value));
+		return keys_.size() != max_num_keys_;
+	}
+
+	const test::Tools::KeysMap &keys() const { return keys_; }
+
+private:
+	test::Tools::KeysMap keys_;
+	std::size_t max_num_keys_;
+};
+
+template <typename TRIE_TYPE>
+void test_trie(const sumire::TrieBase &basic_trie,
+	const test::Tools::KeysMap &keys)
+{
+	TRIE_TYPE trie;
+	trie.build(basic_trie);
+
+	char key[test::Tools::KEY_LENGTH + 1];
+	sumire::UInt32 indices[test::Tools::KEY_LENGTH + 1];
+
+	KeyCollector collector;
+	assert(sumire::for_each_key(trie, "", &collector, key, indices) ==
+		sumire::ForEachKey::COMPLETED);
+	assert(collector.keys() == keys);
+
+	// Keys are too long for the buffer.
+	char short_key[test::Tools::KEY_LENGTH];
+	sumire::UInt32 short_indices[test::Tools::KEY_LENGTH];
+	KeyCollector short_collector;
+	assert(sumire::for_each_key(trie, "", &short_collector, short_key,
+		short_indices) == sumire::ForEachKey::KEY_TOO_LONG);
+	assert(short_collector.keys().empty());
+
+	KeyCollector stopped_collector(10);
+	assert(sumire::for_each_key(trie, "", &stopped_collector, key,
+		indices) == sumire::ForEachKey::STOPPED);
+	assert(stopped_collector.keys().size() == 10);
+
+	const std::string &first_key = keys.begin()->first;
+	for (std::size_t length = 1; length <= first_key.length(); ++length)
+	{
+		std::string prefix = first_key.substr(0, length);
+
+		test::Tools::KeysMap expected_keys;
+		for (test::Tools::KeysIterator it = keys.lower_bound(prefix);
+			it != keys.end() && it->first.compare(0, length, prefix) == 0; ++it)
+			expected_keys.insert(*it);
+
+		KeyCollector prefix_collector;
+		assert(sumire::for_each_key(trie, prefix.c_str(),
+			&prefix_collector, key, indices) == sumire::ForEachKey::COMPLETED);
+		assert(prefix_collector.keys() == expected_keys);
+	}
+
+	KeyCollector missing_collector;
+	assert(sumire::for_each_key(trie, "0", &missing_collector, key,
+		indices) == sumire::ForEachKey::COMPLETED);
+	assert(missing_collector.keys().empty());
+}
+
+}  // namespace
+
+int main()
+{
+	test::Tools::KeysMap keys;
+	test::Tools::make_keys(&keys);
+
+	sumire::BasicTrie trie;
+	test::Tools::build_trie(keys, &trie);
+
+	test_trie<sumire::BasicTrie>(trie, keys);
+	test_trie<sumire::TernaryTrie>(trie, keys);
+	test_trie<sumire::DaTrie>(trie, keys);
+	test_trie<sumire::SuccinctTrie<> >(trie, keys);
+	test_trie<sumire::LoudsTrie<> >(trie, keys);
+	test_trie<sumire::LoudsPlusTrie<> >(trie, keys);
+	test_trie<sumire::PatriciaTrie<> >(trie, keys);
+	test_trie<sumire::HybridTrie<> >(trie, keys);
+
+	return 0;
+}
@@ -0,0 +1,167 @@
+#include <sumire/trie-builder.h>
+#include <sumire/basic-trie.h>
+#include <sumire/da-trie.h>
+#include <sumire/louds-plus-trie.h>
+#include <sumire/patricia-trie.h>
+#include <sumire/fuzzy-searcher.h>
+
+#include <algorithm>
+#include <functional>
+#include <set>
+
+#include "test-tools.h"
+
+namespace {
+
+// Returns the distance between a query and the prefix of a key that is
+// the closest to the query if is_prefix is true.
+sumire::UInt32 get_distance(const std::string &lhs, const std::string &rhs,
+	bool is_prefix = false)
+{
+	std::vector<sumire::UInt32> row(rhs.length() + 1);
+	for (std::size_t j = 0; j < row.size(); ++j)
+		row[j] = static_cast<sumire::UInt32>(j);
+
+	std::vector<sumire::UInt32> next_row(row.size());
+	sumire::UInt32 min_distance = row.back();
+	for (std::size_t i = 1; i <= lhs.length(); ++i)
+	{
+		next_row[0] = static_cast<sumire::UInt32>(i);
+		for (std::size_t j = 1; j < row.size(); ++j)
+		{
+			sumire::UInt32 cost = (lhs[i - 1] != rhs[j - 1]) ? 1 : 0;
+			next_row[j] = std::min(row[j - 1] + cost,
+				std::min(row[j], next_row[j - 1]) + 1);
+		}
+		row.swap(next_row);
+		min_distance = std::min(min_distance, row.back());
+	}
+	return is_prefix ? min_distance : row.back();
+}
+
+// Makes a query from a key with an insertion, a deletion and a
+// substitution.
+std::string make_query(const std::string &key)
+{
+	std::string query = key;
+	query.insert(std::rand() % (query.length() + 1), 1,
+		'A' + (std::rand() % 26));
+	query.erase(std::rand() % query.length(), 1);
+	query[std::rand() % query.length()] = 'A' + (std::rand() % 26);
+	return query;
+}
+
+void test_search(const sumire::TrieBase &trie,
+	const test::Tools::KeysMap &keys, const std::string &query,
+	sumire::UInt32 max_distance)
+{
+	std::set<std::string> expected_keys;
+	for (test::Tools::KeysIterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		if (get_distance(it->first, query) <= max_distance)
+			expected_keys.insert(it->first);
+	}
+
+	sumire::FuzzySearcher searcher;
+	assert(searcher.start(trie, query.c_str(), max_distance) == true);
+
+	std::set<std::string> results;
+	while (searcher.next())
+	{
+		test::Tools::KeysIterator it = keys.find(searcher.key());
+		assert(it != keys.end());
+		assert(it->second == searcher.value());
+		assert(searcher.length() == it->first.length());
+		assert(searcher.distance() == get_distance(it->first, query));
+		assert(results.insert(searcher.key()).second == true);
+	}
+	assert(results == expected_keys);
+	assert(searcher.next() == false);
+}
+
+void test_completion(const sumire::TrieBase &trie,
+	const sumire::MaxValueTable *max_values,
+	const test::Tools::KeysMap &keys, const std::string &query,
+	sumire::UInt32 max_distance, sumire::UInt32 max_num_results)
+{
+	std::vector<sumire::UInt32> values;
+	for (test::Tools::KeysIterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		if (get_distance(it->first, query, true) <= max_distance)
+			values.push_back(it->second);
+	}
+	std::sort(values.begin(), values.end(),
+		std::greater<sumire::UInt32>());
+	if (values.size() > max_num_results)
+		values.resize(max_num_results);
+
+	sumire::FuzzySearcher searcher;
+	assert(searcher.start_completion(trie, query.c_str(), max_distance,
+		max_num_results, max_values) == true);
+
+	std::set<std::string> results;
+	while (searcher.next())
+	{
+		test::Tools::KeysIterator it = keys.find(searcher.key());
+		assert(it != keys.end());
+		assert(it->second == searcher.value());
+		assert(searcher.distance() <= max_distance);
+		assert(searcher.distance() >= get_distance(it->first, query, true));
+
+		assert(results.size() < values.size());
+		assert(searcher.value() == values[results.size()]);
+		assert(results.insert(searcher.key()).second == true);
+	}
+	assert(results.size() == values.size());
+}
+
+template <typename TRIE_TYPE>
+void test_trie(const sumire::TrieBase &basic_trie,
+	const test::Tools::KeysMap &keys)
+{
+	TRIE_TYPE trie;
+	trie.build(basic_trie);
+
+	sumire::MaxValueTable max_values;
+	max_values.build(trie);
+
+	test::Tools::KeysIterator it = keys.begin();
+	for (int i = 0; i < 2; ++i, ++it)
+	{
+		std::string query = make_query(it->first);
+		test_search(trie, keys, it->first, 0);
+		test_search(trie, keys, query, 1);
+		test_search(trie, keys, query, 2);
+
+		test_completion(trie, &max_values, keys,
+			query.substr(0, 3), 1, 10);
+	}
+	test_search(trie, keys, "", 0);
+}
+
+}  // namespace
+
+int main()
+{
+	test::Tools::KeysMap keys;
+	test::Tools::make_keys(&keys);
+
+	sumire::BasicTrie trie;
+	test::Tools::build_trie(keys, &trie);
+
+	test_trie<sumire::BasicTrie>(trie, keys);
+	test_trie<sumire::DaTrie>(trie, keys);
+	test_trie<sumire::LoudsPlusTrie<> >(trie, keys);
+	test_trie<sumire::PatriciaTrie<> >(trie, keys);
+
+	trie.build(trie, sumire::BasicTrie::MAX_VALUE_ORDER);
+
+	test::Tools::KeysIterator it = keys.begin();
+	for (int i = 0; i < 3; ++i, ++it)
+	{
+		test_completion(trie, NULL, keys, it->first.substr(0, 2), 1, 10);
+		test_completion(trie, NULL, keys, it->first.substr(0, 4), 2, 20);
+	}
+
+	return 0;
+}
@@ -0,0 +1,60 @@
+#include <sumire/basic-trie.h>
+#include <sumire/hybrid-succinct-bit-vector.h>
+#include <sumire/hybrid-trie.h>
+#include <sumire/trie-builder.h>
+
+#include "test-tools.h"
+
+namespace {
+
+template <typename TRIE_TYPE>
+void test_levels(const test::Tools::KeysMap &keys)
+{
+	sumire::TrieBuilder builder;
+	for (test::Tools::KeysIterator it = keys.begin(); it != keys.end(); ++it)
+		assert(builder.insert(it->first.c_str(), it->second));
+	assert(builder.finish() == true);
+
+	// A trie without links is a double-array with a LOUDS++ trie, and a
+	// trie with deep levels has no LOUDS++ nodes to follow.
+	for (sumire::UInt32 num_da_levels = 0; num_da_levels < 64;
+		num_da_levels = (num_da_levels * 4) + 1)
+	{
+		TRIE_TYPE trie;
+		assert(trie.build(builder.virtual_trie(), num_da_levels) == true);
+		assert(trie.num_nodes() == builder.virtual_trie().num_nodes());
+		assert(trie.num_da_nodes() <= trie.num_nodes());
+
+		FIND_ALL_KEYS(trie, keys)
+	}
+}
+
+template <typename TRIE_TYPE>
+void test_trie(const test::Tools::KeysMap &keys)
+{
+	TRIE_TYPE trie;
+	test::Tools::build_trie(keys, &trie);
+	test::Tools::test_find_child(trie);
+
+	assert(trie.num_da_nodes() < trie.num_nodes());
+	assert(trie.num_links() > 0);
+
+	test::Tools::test_reload(trie, keys);
+	test::Tools::test_map(trie, keys);
+	test::Tools::test_clear(&trie);
+}
+
+}  // namespace
+
+int main()
+{
+	test::Tools::KeysMap keys;
+	test::Tools::make_keys(&keys);
+
+	test_trie<sumire::HybridTrie<> >(keys);
+	test_trie<sumire::HybridTrie<sumire::HybridSuccinctBitVector> >(keys);
+
+	test_levels<sumire::HybridTrie<> >(keys);
+
+	return 0;
+}
@@ -0,0 +1,136 @@
+#include <sumire/trie-builder.h>
+#include <sumire/basic-trie.h>
+#include <sumire/ternary-trie.h>
+#include <sumire/da-trie.h>
+#include <sumire/succinct-trie.h>
+#include <sumire/hybrid-trie.h>
+#include <sumire/louds-plus-trie.h>
+#include <sumire/louds-trie.h>
+#include <sumire/patricia-trie.h>
+#include <sumire/key-count-table.h>
+
+#include <sstream>
+
+#include "test-tools.h"
+
+namespace {
+
+void test_prefix(const sumire::KeyCountTable &table,
+	const sumire::TrieBase &trie, const test::Tools::KeysMap &keys,
+	const std::string &prefix)
+{
+	sumire::UInt32 num_keys = 0;
+	sumire::UInt64 sum = 0;
+	for (test::Tools::KeysIterator it = keys.lower_bound(prefix);
+		it != keys.end() && it->first.compare(
+		0, prefix.length(), prefix) == 0; ++it)
+	{
+		++num_keys;
+		sum += it->second;
+	}
+
+	assert(table.count_keys(trie, prefix.c_str()) == num_keys);
+	assert(table.sum_values(trie, prefix.c_str()) == sum);
+}
+
+template <typename TRIE_TYPE>
+void test_trie(const sumire::TrieBase &basic_trie,
+	const test::Tools::KeysMap &keys)
+{
+	TRIE_TYPE trie;
+	trie.build(basic_trie);
+
+	sumire::KeyCountTable table;
+	table.build(trie, sumire::KeyCountTable::KEY_COUNTS_AND_VALUE_SUMS);
+	assert(table.has_value_sums() == true);
+	assert(table.num_units() == trie.num_units());
+
+	sumire::UInt64 sum = 0;
+	for (test::Tools::KeysIterator it = keys.begin(); it != keys.end(); ++it)
+		sum += it->second;
+	assert(table.num_keys(trie.root()) == keys.size());
+	assert(table.sum_values(trie.root()) == sum);
+
+	test::Tools::KeysIterator key_it = keys.begin();
+	for (int i = 0; i < 100; ++i)
+	{
+		std::advance(key_it, std::rand() % 256);
+		if (key_it == keys.end())
+			key_it = keys.begin();
+
+		for (std::size_t length = 0; length <= key_it->first.length();
+			++length)
+			test_prefix(table, trie, keys, key_it->first.substr(0, length));
+	}
+
+	// Prefixes that are not in the trie.
+	assert(table.count_keys(trie, "a") == 0);
+	assert(table.sum_values(trie, "a") == 0);
+	assert(table.count_keys(trie, "AAAAAAAAA") == 0);
+
+	sumire::KeyCountTable count_table;
+	count_table.build(trie);
+	assert(count_table.has_value_sums() == false);
+	assert(count_table.size() < table.size());
+	for (sumire::UInt32 index = 0; index < trie.num_units(); ++index)
+		assert(count_table.num_keys(index) == table.num_keys(index));
+}
+
+void test_io(const sumire::BasicTrie &trie, const test::Tools::KeysMap &keys)
+{
+	sumire::KeyCountTable table;
+	table.build(trie, sumire::KeyCountTable::KEY_COUNTS_AND_VALUE_SUMS);
+
+	std::stringstream stream;
+	assert(table.write(&stream) == true);
+
+	sumire::KeyCountTable table_read;
+	assert(table_read.read(&stream) == true);
+	assert(table_read.size() == table.size());
+	for (sumire::UInt32 index = 0; index < trie.num_units(); ++index)
+	{
+		assert(table_read.num_keys(index) == table.num_keys(index));
+		assert(table_read.sum_values(index) == table.sum_values(index));
+	}
+
+	std::string data = stream.str();
+	sumire::KeyCountTable table_mapped;
+	table_mapped.map(&data[0]);
+	for (sumire::UInt32 index = 0; index < trie.num_units(); ++index)
+	{
+		assert(table_mapped.num_keys(index) == table.num_keys(index));
+		assert(table_mapped.sum_values(index) == table.sum_values(index));
+	}
+	assert(table_mapped.count_keys(trie, "") == keys.size());
+
+	table_mapped.swap(&table);
+	assert(table.num_units() == trie.num_units());
+
+	table.clear();
+	assert(table.num_units() == 0);
+	assert(table.size() == 0);
+}
+
+}  // namespace
+
+int main()
+{
+	test::Tools::KeysMap keys;
+	test::Tools::make_keys(&keys);
+
+	sumire::BasicTrie trie;
+	test::Tools::build_trie(keys, &trie);
+
+	test_trie<sumire::BasicTrie>(trie, keys);
+	test_trie<sumire::TernaryTrie>(trie, keys);
+	test_trie<sumire::DaTrie>(trie, keys);
+	test_trie<sumire::SuccinctTrie<> >(trie, keys);
+	test_trie<sumire::LoudsTrie<> >(trie, keys);
+	test_trie<sumire::LoudsPlusTrie<> >(trie, keys);
+	test_trie<sumire::PatriciaTrie<> >(trie, keys);
+	test_trie<sumire::HybridTrie<> >(trie, keys);
+
+	test_io(trie, keys);
+
+	return 0;
+}
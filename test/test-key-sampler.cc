@@ -0,0 +1,227 @@
+#include <sumire/trie-builder.h>
+#include <sumire/basic-trie.h>
+#include <sumire/ternary-trie.h>
+#include <sumire/da-trie.h>
+#include <sumire/succinct-trie.h>
+#include <sumire/hybrid-trie.h>
+#include <sumire/louds-plus-trie.h>
+#include <sumire/louds-trie.h>
+#include <sumire/patricia-trie.h>
+#include <sumire/key-sampler.h>
+
+#include "test-tools.h"
+
+namespace {
+
+// Returns a random integer in [0, n).
+class Random
+{
+public:
+	Random() : state_(88172645463325252ULL) {}
+
+	sumire::UInt64 operator()(sumire::UInt64 n)
+	{
+		state_ ^= state_ << 13;
+		state_ ^= state_ >> 7;
+		state_ ^= state_ << 17;
+		return state_ % n;
+	}
+
+private:
+	sumire::UInt64 state_;
+};
+
+// Takes and returns int, as many generators for std::random_shuffle() do.
+class IntRandom
+{
+public:
+	IntRandom() : random_() {}
+
+	int operator()(int n)
+	{
+		assert(n > 0);
+		return static_cast<int>(random_(static_cast<sumire::UInt64>(n)));
+	}
+
+private:
+	Random random_;
+};
+
+// Every position picks a key, and each key is picked as many times as its
+// weight, in dictionary order.
+void test_positions(sumire::KeySampler *sampler,
+	const test::Tools::KeysMap &keys, bool is_weighted)
+{
+	test::Tools::KeysIterator key_it = keys.begin();
+	sumire::UInt64 count = 0;
+	for (sumire::UInt64 position = 0; position < sampler->total_weight();
+		++position)
+	{
+		while (key_it != keys.end() &&
+			count == (is_weighted ? key_it->second : 1))
+		{
+			++key_it;
+			count = 0;
+		}
+		assert(key_it != keys.end());
+
+		assert(sampler->pick(position) == true);
+		assert(key_it->first == sampler->key());
+		assert(key_it->first.length() == sampler->length());
+		assert(key_it->second == sampler->value());
+		++count;
+	}
+	assert(sampler->pick(sampler->total_weight()) == false);
+}
+
+void test_random(sumire::KeySampler *sampler,
+	const test::Tools::KeysMap &keys, bool is_weighted)
+{
+	Random rng;
+	for (int i = 0; i < 1000; ++i)
+	{
+		assert(sampler->next(&rng) == true);
+
+		test::Tools::KeysIterator it = keys.find(sampler->key());
+		assert(it != keys.end());
+		assert(it->second == sampler->value());
+		assert(!is_weighted || it->second != 0);
+	}
+}
+
+template <typename TRIE_TYPE>
+void test_trie(const sumire::TrieBase &basic_trie,
+	const test::Tools::KeysMap &keys)
+{
+	TRIE_TYPE trie;
+	trie.build(basic_trie);
+
+	sumire::KeyCountTable table;
+	table.build(trie, sumire::KeyCountTable::KEY_COUNTS_AND_VALUE_SUMS);
+
+	sumire::KeySampler sampler;
+	assert(sampler.start(trie, table, trie.root()) == true);
+	assert(sampler.total_weight() == keys.size());
+	test_positions(&sampler, keys, false);
+
+	assert(sampler.start(trie, table, trie.root(),
+		sumire::KeySampler::VALUE_WEIGHT) == true);
+	test_random(&sampler, keys, true);
+
+	// Keys are relative to the start node.
+	std::string prefix = keys.begin()->first.substr(0, 2);
+	sumire::UInt32 index;
+	assert(trie.follow(trie.root(), prefix.c_str(), &index) == true);
+
+	test::Tools::KeysMap suffixes;
+	for (test::Tools::KeysIterator it = keys.lower_bound(prefix);
+		it != keys.end() && it->first.compare(0, 2, prefix) == 0; ++it)
+		suffixes.insert(std::make_pair(it->first.substr(2), it->second));
+
+	assert(sampler.start(trie, table, index,
+		sumire::KeySampler::VALUE_WEIGHT) == true);
+	test_positions(&sampler, suffixes, true);
+
+	assert(sampler.start(trie, table, index) == true);
+	test_random(&sampler, suffixes, false);
+}
+
+// Samples follow the weights of keys.
+void test_distribution(const sumire::BasicTrie &trie,
+	const test::Tools::KeysMap &keys)
+{
+	std::string prefix = keys.begin()->first.substr(0, 2);
+	sumire::UInt32 index;
+	assert(trie.follow(trie.root(), prefix.c_str(), &index) == true);
+
+	sumire::KeyCountTable table;
+	table.build(trie, sumire::KeyCountTable::KEY_COUNTS_AND_VALUE_SUMS);
+
+	sumire::KeySampler sampler;
+	assert(sampler.start(trie, table, index,
+		sumire::KeySampler::VALUE_WEIGHT) == true);
+
+	const sumire::UInt64 NUM_SAMPLES_PER_WEIGHT = 200;
+	sumire::UInt64 num_samples =
+		sampler.total_weight() * NUM_SAMPLES_PER_WEIGHT;
+
+	std::map<std::string, sumire::UInt64> counts;
+	Random rng;
+	for (sumire::UInt64 i = 0; i < num_samples; ++i)
+	{
+		assert(sampler.next(&rng) == true);
+		++counts[sampler.key()];
+	}
+
+	for (test::Tools::KeysIterator it = keys.lower_bound(prefix);
+		it != keys.end() && it->first.compare(0, 2, prefix) == 0; ++it)
+	{
+		sumire::UInt64 expected = it->second * NUM_SAMPLES_PER_WEIGHT;
+		sumire::UInt64 count = counts[it->first.substr(2)];
+		assert(count * 2 >= expected);
+		assert(count <= expected * 2);
+	}
+}
+
+// Weights beyond the range of int are sampled evenly with an int RNG.
+void test_large_weights()
+{
+	const sumire::UInt32 MAX_WEIGHT = 0x7FFFFFFFU;
+
+	test::Tools::KeysMap keys;
+	for (char label = 'a'; label <= 'h'; ++label)
+		keys.insert(std::make_pair(std::string(1, label), MAX_WEIGHT));
+
+	sumire::BasicTrie trie;
+	test::Tools::build_trie(keys, &trie);
+
+	sumire::KeyCountTable table;
+	table.build(trie, sumire::KeyCountTable::KEY_COUNTS_AND_VALUE_SUMS);
+
+	sumire::KeySampler sampler;
+	assert(sampler.start(trie, table, trie.root(),
+		sumire::KeySampler::VALUE_WEIGHT) == true);
+	assert(sampler.total_weight() ==
+		static_cast<sumire::UInt64>(MAX_WEIGHT) * keys.size());
+
+	const sumire::UInt64 NUM_SAMPLES_PER_KEY = 1000;
+	std::map<std::string, sumire::UInt64> counts;
+	IntRandom rng;
+	for (sumire::UInt64 i = 0; i < NUM_SAMPLES_PER_KEY * keys.size(); ++i)
+	{
+		assert(sampler.next(&rng) == true);
+		++counts[sampler.key()];
+	}
+
+	for (test::Tools::KeysIterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		sumire::UInt64 count = counts[it->first];
+		assert(count * 2 >= NUM_SAMPLES_PER_KEY);
+		assert(count <= NUM_SAMPLES_PER_KEY * 2);
+	}
+}
+
+}  // namespace
+
+int main()
+{
+	test::Tools::KeysMap keys;
+	test::Tools::make_keys(&keys);
+
+	sumire::BasicTrie trie;
+	test::Tools::build_trie(keys, &trie);
+
+	test_trie<sumire::BasicTrie>(trie, keys);
+	test_trie<sumire::TernaryTrie>(trie, keys);
+	test_trie<sumire::DaTrie>(trie, keys);
+	test_trie<sumire::SuccinctTrie<> >(trie, keys);
+	test_trie<sumire::LoudsTrie<> >(trie, keys);
+	test_trie<sumire::LoudsPlusTrie<> >(trie, keys);
+	test_trie<sumire::PatriciaTrie<> >(trie, keys);
+	test_trie<sumire::HybridTrie<> >(trie, keys);
+
+	test_distribution(trie, keys);
+	test_large_weights();
+
+	return 0;
+}
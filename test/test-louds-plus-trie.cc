@@ -11,6 +11,7 @@ int main()
 
 	sumire::LoudsPlusTrie<> trie;
 	test::Tools::build_trie(keys, &trie);
+	test::Tools::test_find_child(trie);
 
 	test::Tools::test_reload(trie, keys);
 	test::Tools::test_map(trie, keys);
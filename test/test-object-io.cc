@@ -1,6 +1,8 @@
 #include <sumire/object-clipper.h>
 #include <sumire/object-reader.h>
 #include <sumire/object-writer.h>
+#include <sumire/var-int-reader.h>
+#include <sumire/var-int-writer.h>
 
 #include <cassert>
 #include <cstring>
@@ -49,5 +51,33 @@ int main()
 	const char *str = clipper.clip<char>(6);
 	assert(std::strcmp(str, "orange") == 0);
 
+	std::stringstream var_int_stream;
+
+	sumire::VarIntReader var_int_reader(&var_int_stream);
+	sumire::VarIntWriter var_int_writer(&var_int_stream);
+
+	assert(var_int_writer.write(0));
+	assert(var_int_writer.write(0x7F));
+	assert(var_int_writer.write(0x80));
+	assert(var_int_writer.write(sumire::UInt32Limits::max()));
+	assert(var_int_stream.str().length() == 1 + 1 + 2 + 5);
+
+	sumire::UInt32 var_int;
+	assert(var_int_reader.read(&var_int));
+	assert(var_int == 0);
+	assert(var_int_reader.read(&var_int));
+	assert(var_int == 0x7F);
+	assert(var_int_reader.read(&var_int));
+	assert(var_int == 0x80);
+	assert(var_int_reader.read(&var_int));
+	assert(var_int == sumire::UInt32Limits::max());
+
+	assert(!var_int_reader.read(&var_int));
+
+	// An integer that does not fit in a UInt32 is rejected.
+	var_int_stream.clear();
+	var_int_stream.str("\xFF\xFF\xFF\xFF\x1F");
+	assert(!var_int_reader.read(&var_int));
+
 	return 0;
 }
@@ -0,0 +1,164 @@
+#include <sumire/trie-builder.h>
+#include <sumire/basic-trie.h>
+#include <sumire/ternary-trie.h>
+#include <sumire/da-trie.h>
+#include <sumire/succinct-trie.h>
+#include <sumire/hybrid-trie.h>
+#include <sumire/louds-plus-trie.h>
+#include <sumire/louds-trie.h>
+#include <sumire/patricia-trie.h>
+#include <sumire/parallel-completer.h>
+
+#include <algorithm>
+#include <functional>
+#include <set>
+
+#include "test-tools.h"
+
+namespace {
+
+void test_dictionary_order(sumire::ParallelCompleter *completer,
+	const test::Tools::KeysMap &keys, std::size_t max_num_results)
+{
+	std::size_t num_results = 0;
+	test::Tools::KeysIterator key_it = keys.begin();
+	while (completer->next())
+	{
+		assert(key_it != keys.end());
+		assert(key_it->first == completer->key());
+		assert(key_it->first.length() == completer->length());
+		assert(key_it->second == completer->value());
+		++key_it;
+		++num_results;
+	}
+	assert(num_results == std::min(keys.size(), max_num_results));
+	assert(completer->next() == false);
+}
+
+void test_value_order(sumire::ParallelCompleter *completer,
+	const test::Tools::KeysMap &keys, std::size_t max_num_results)
+{
+	std::vector<sumire::UInt32> values;
+	for (test::Tools::KeysIterator it = keys.begin(); it != keys.end(); ++it)
+		values.push_back(it->second);
+	std::sort(values.begin(), values.end(),
+		std::greater<sumire::UInt32>());
+	if (values.size() > max_num_results)
+		values.resize(max_num_results);
+
+	std::set<std::string> results;
+	while (completer->next())
+	{
+		test::Tools::KeysIterator it = keys.find(completer->key());
+		assert(it != keys.end());
+		assert(it->second == completer->value());
+		assert(it->first.length() == completer->length());
+
+		assert(results.size() < values.size());
+		assert(completer->value() == values[results.size()]);
+		assert(results.insert(completer->key()).second == true);
+	}
+	assert(results.size() == values.size());
+	assert(completer->next() == false);
+}
+
+template <typename TRIE_TYPE>
+void test_trie(const sumire::TrieBase &basic_trie,
+	const sumire::TrieBase &max_value_order_trie,
+	const test::Tools::KeysMap &keys)
+{
+	TRIE_TYPE trie;
+	trie.build(basic_trie);
+
+	sumire::ParallelCompleter completer;
+	assert(completer.start(trie, trie.root()) == true);
+	assert(completer.num_ranges() >= 256);
+	test_dictionary_order(&completer, keys, keys.size());
+
+	trie.build(max_value_order_trie);
+
+	assert(completer.start(trie, trie.root(),
+		sumire::ParallelCompleter::VALUE_ORDER) == true);
+	test_value_order(&completer, keys, keys.size());
+
+	assert(completer.start(trie, trie.root(),
+		sumire::ParallelCompleter::VALUE_ORDER, 100) == true);
+	test_value_order(&completer, keys, 100);
+}
+
+void test_ranges(const sumire::BasicTrie &trie,
+	const sumire::BasicTrie &max_value_order_trie,
+	const test::Tools::KeysMap &keys)
+{
+	sumire::ParallelCompleter completer;
+	assert(completer.start(trie, trie.root(),
+		sumire::ParallelCompleter::DICTIONARY_ORDER, 1000, 1) == true);
+	assert(completer.num_ranges() == 1);
+	test_dictionary_order(&completer, keys, 1000);
+
+	// Every key gets its own range.
+	assert(completer.start(trie, trie.root(),
+		sumire::ParallelCompleter::DICTIONARY_ORDER,
+		sumire::UInt32Limits::max(), sumire::UInt32Limits::max()) == true);
+	assert(completer.num_ranges() == keys.size());
+	test_dictionary_order(&completer, keys, keys.size());
+
+	// Small buffers are refilled many times.
+	assert(completer.start(trie, trie.root(),
+		sumire::ParallelCompleter::DICTIONARY_ORDER,
+		sumire::UInt32Limits::max(), 4, 3) == true);
+	test_dictionary_order(&completer, keys, keys.size());
+
+	assert(completer.start(max_value_order_trie, max_value_order_trie.root(),
+		sumire::ParallelCompleter::VALUE_ORDER, 1000, 4, 1) == true);
+	test_value_order(&completer, keys, 1000);
+
+	// Keys are relative to the start node.
+	std::string prefix = keys.begin()->first.substr(0, 2);
+	sumire::UInt32 index;
+	assert(trie.follow(trie.root(), prefix.c_str(), &index) == true);
+
+	test::Tools::KeysMap suffixes;
+	for (test::Tools::KeysIterator it = keys.lower_bound(prefix);
+		it != keys.end() && it->first.compare(0, 2, prefix) == 0; ++it)
+		suffixes.insert(std::make_pair(it->first.substr(2), it->second));
+
+	assert(completer.start(trie, index) == true);
+	test_dictionary_order(&completer, suffixes, suffixes.size());
+
+	assert(max_value_order_trie.follow(
+		max_value_order_trie.root(), prefix.c_str(), &index) == true);
+	assert(completer.start(max_value_order_trie, index,
+		sumire::ParallelCompleter::VALUE_ORDER, 10, 4) == true);
+	test_value_order(&completer, suffixes, 10);
+
+	completer.clear();
+	assert(completer.num_ranges() == 0);
+}
+
+}  // namespace
+
+int main()
+{
+	test::Tools::KeysMap keys;
+	test::Tools::make_keys(&keys);
+
+	sumire::BasicTrie trie;
+	test::Tools::build_trie(keys, &trie);
+
+	sumire::BasicTrie max_value_order_trie;
+	max_value_order_trie.build(trie, sumire::BasicTrie::MAX_VALUE_ORDER);
+
+	test_trie<sumire::BasicTrie>(trie, max_value_order_trie, keys);
+	test_trie<sumire::TernaryTrie>(trie, max_value_order_trie, keys);
+	test_trie<sumire::DaTrie>(trie, max_value_order_trie, keys);
+	test_trie<sumire::SuccinctTrie<> >(trie, max_value_order_trie, keys);
+	test_trie<sumire::LoudsTrie<> >(trie, max_value_order_trie, keys);
+	test_trie<sumire::LoudsPlusTrie<> >(trie, max_value_order_trie, keys);
+	test_trie<sumire::PatriciaTrie<> >(trie, max_value_order_trie, keys);
+	test_trie<sumire::HybridTrie<> >(trie, max_value_order_trie, keys);
+
+	test_ranges(trie, max_value_order_trie, keys);
+
+	return 0;
+}
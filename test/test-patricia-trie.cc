@@ -0,0 +1,186 @@
+#include <sumire/basic-trie.h>
+#include <sumire/hybrid-succinct-bit-vector.h>
+#include <sumire/patricia-trie.h>
+#include <sumire/simplified-succinct-bit-vector.h>
+#include <sumire/trie-builder.h>
+
+#include <algorithm>
+
+#include "test-tools.h"
+
+namespace {
+
+// Keys of various lengths over a small alphabet, many of which are
+// prefixes of others, so that edges end at values in the middle of chains.
+void make_prefix_keys(test::Tools::KeysMap *keys)
+{
+	// A long chain has values at some of its nodes.
+	std::string chain(40, 'Z');
+	const std::size_t CHAIN_LENGTHS[] = { 1, 2, 7, 8, 20, 39, 40 };
+	for (std::size_t i = 0; i < sizeof(CHAIN_LENGTHS) / sizeof(std::size_t);
+		++i)
+	{
+		keys->insert(std::make_pair(chain.substr(0, CHAIN_LENGTHS[i]),
+			static_cast<sumire::UInt32>(i)));
+	}
+
+	while (keys->size() < test::Tools::NUM_KEYS / 4)
+	{
+		std::string key;
+		std::size_t length = 1 + (std::rand() % 16);
+		while (key.length() < length)
+			key += static_cast<char>('A' + (std::rand() % 4));
+		keys->insert(std::make_pair(key,
+			std::rand() % test::Tools::MAX_VALUE));
+
+		if (std::rand() % 2 == 0)
+		{
+			key.resize(1 + (std::rand() % key.length()));
+			keys->insert(std::make_pair(key,
+				std::rand() % test::Tools::MAX_VALUE));
+		}
+	}
+}
+
+template <typename TRIE_TYPE>
+void test_edges(const TRIE_TYPE &trie, const test::Tools::KeysMap &keys)
+{
+	// Keys share only short prefixes, so most nodes are in tails.
+	assert(trie.num_edges() < trie.num_nodes() / 2);
+	assert(trie.num_tails() > 0);
+
+	// Labels are followed one by one through TrieBase, and keys are
+	// followed edge by edge through PatriciaTrie.
+	const sumire::TrieBase &base = trie;
+	sumire::UInt32 key_id = 0;
+	for (test::Tools::KeysIterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		sumire::UInt32 value;
+		assert(base.find(it->first.c_str(), &value));
+		assert(value == it->second);
+
+		if (key_id++ % 16 != 0)
+			continue;
+
+		for (sumire::UInt32 length = 0; length <= it->first.length();
+			++length)
+		{
+			sumire::UInt32 index, base_index;
+			assert(trie.follow(trie.root(), it->first.c_str(), length,
+				&index));
+			assert(base.follow(base.root(), it->first.c_str(), length,
+				&base_index));
+			assert(index == base_index);
+
+			// The rest of the key is followed from the middle of an edge.
+			sumire::UInt32 last_index;
+			assert(trie.follow(index, it->first.c_str() + length,
+				&last_index));
+			assert(trie.get_value(last_index, &value));
+			assert(value == it->second);
+		}
+
+		std::string missing_key = it->first + '\x01';
+		assert(!trie.find(missing_key.c_str()));
+		missing_key = it->first.substr(0, it->first.length() - 1);
+		assert(!trie.find(missing_key.c_str()) ||
+			keys.find(missing_key) != keys.end());
+	}
+}
+
+template <typename TRIE_TYPE>
+void test_trie(const test::Tools::KeysMap &keys)
+{
+	TRIE_TYPE trie;
+	test::Tools::build_trie(keys, &trie);
+	test::Tools::test_find_child(trie);
+
+	test_edges(trie, keys);
+
+	test::Tools::test_reload(trie, keys);
+	test::Tools::test_map(trie, keys);
+	test::Tools::test_clear(&trie);
+}
+
+template <typename TRIE_TYPE>
+void test_labels(const TRIE_TYPE &trie, const TRIE_TYPE &flat_trie)
+{
+	// Labels are read in random order, so that a nested trie restores
+	// tails up to various offsets.
+	std::vector<sumire::UInt32> indices;
+	std::vector<sumire::UInt32> stack(1, flat_trie.root());
+	while (!stack.empty())
+	{
+		sumire::UInt32 index = stack.back();
+		stack.pop_back();
+		indices.push_back(index);
+		for (sumire::UInt32 child_index = flat_trie.child(index);
+			child_index != 0; child_index = flat_trie.sibling(child_index))
+			stack.push_back(child_index);
+	}
+	std::random_shuffle(indices.begin(), indices.end());
+	if (indices.size() > (1 << 14))
+		indices.resize(1 << 14);
+
+	for (std::size_t i = 0; i < indices.size(); ++i)
+	{
+		assert(trie.label(indices[i]) == flat_trie.label(indices[i]));
+		assert(trie.child(indices[i]) == flat_trie.child(indices[i]));
+	}
+}
+
+template <typename TRIE_TYPE>
+void test_nested_trie(const test::Tools::KeysMap &keys,
+	sumire::UInt32 num_nested_levels)
+{
+	sumire::TrieBuilder builder;
+	for (test::Tools::KeysIterator it = keys.begin(); it != keys.end(); ++it)
+		assert(builder.insert(it->first.c_str(), it->second));
+	assert(builder.finish() == true);
+
+	TRIE_TYPE flat_trie;
+	assert(flat_trie.build(builder.virtual_trie()) == true);
+	assert(flat_trie.num_nested_levels() == 0);
+
+	TRIE_TYPE trie;
+	assert(trie.build(builder.virtual_trie(), num_nested_levels) == true);
+	assert(trie.num_nested_levels() == num_nested_levels);
+	assert(trie.num_nodes() == flat_trie.num_nodes());
+	assert(trie.num_tails() == flat_trie.num_tails());
+
+	FIND_ALL_KEYS(trie, keys)
+
+	test::Tools::test_find_child(trie);
+
+	test_edges(trie, keys);
+	test_labels(trie, flat_trie);
+
+	test::Tools::test_reload(trie, keys);
+	test::Tools::test_map(trie, keys);
+	test::Tools::test_clear(&trie);
+}
+
+}  // namespace
+
+int main()
+{
+	test::Tools::KeysMap keys;
+	test::Tools::make_keys(&keys);
+
+	test_trie<sumire::PatriciaTrie<> >(keys);
+	test_trie<sumire::PatriciaTrie<sumire::SimplifiedSuccinctBitVector> >(
+		keys);
+	test_trie<sumire::PatriciaTrie<sumire::HybridSuccinctBitVector> >(keys);
+
+	test_nested_trie<sumire::PatriciaTrie<> >(keys, 1);
+	test_nested_trie<sumire::PatriciaTrie<> >(keys, 2);
+
+	test::Tools::KeysMap prefix_keys;
+	make_prefix_keys(&prefix_keys);
+
+	test_trie<sumire::PatriciaTrie<> >(prefix_keys);
+	test_nested_trie<sumire::PatriciaTrie<> >(prefix_keys, 1);
+	test_nested_trie<sumire::PatriciaTrie<> >(prefix_keys, 2);
+
+	return 0;
+}
@@ -0,0 +1,145 @@
+#include <sumire/trie-builder.h>
+#include <sumire/basic-trie.h>
+#include <sumire/ternary-trie.h>
+#include <sumire/da-trie.h>
+#include <sumire/succinct-trie.h>
+#include <sumire/hybrid-trie.h>
+#include <sumire/louds-plus-trie.h>
+#include <sumire/louds-trie.h>
+#include <sumire/patricia-trie.h>
+#include <sumire/basic-completer.h>
+#include <sumire/prefix-cursor.h>
+
+#include "test-tools.h"
+
+namespace {
+
+// Checks the cursor against follow() from the root.
+void test_cursor(const sumire::PrefixCursor &cursor,
+	const sumire::TrieBase &trie, const test::Tools::KeysMap &keys)
+{
+	assert(std::string(cursor.key()).length() == cursor.length());
+
+	sumire::UInt32 index;
+	if (!trie.follow(trie.root(), cursor.key(), &index))
+	{
+		assert(cursor.is_found() == false);
+		assert(cursor.get_value() == false);
+		return;
+	}
+	assert(cursor.is_found() == true);
+	assert(cursor.index() == index);
+
+	test::Tools::KeysIterator it = keys.find(cursor.key());
+	sumire::UInt32 value;
+	if (it == keys.end())
+		assert(cursor.get_value(&value) == false);
+	else
+	{
+		assert(cursor.get_value(&value) == true);
+		assert(value == it->second);
+	}
+}
+
+void test_completion(const sumire::PrefixCursor &cursor,
+	const test::Tools::KeysMap &keys)
+{
+	std::string prefix = cursor.key();
+
+	sumire::BasicCompleter completer;
+	assert(cursor.complete(&completer) == cursor.is_found());
+	if (!cursor.is_found())
+		return;
+
+	test::Tools::KeysIterator it = keys.lower_bound(prefix);
+	while (completer.next())
+	{
+		assert(it != keys.end());
+		assert(it->first == prefix + completer.key());
+		assert(it->second == completer.value());
+		++it;
+	}
+	assert(it == keys.end() ||
+		it->first.compare(0, prefix.length(), prefix) != 0);
+}
+
+template <typename TRIE_TYPE>
+void test_trie(const sumire::TrieBase &basic_trie,
+	const test::Tools::KeysMap &keys)
+{
+	TRIE_TYPE trie;
+	trie.build(basic_trie);
+
+	sumire::PrefixCursor cursor;
+	assert(cursor.start(trie, trie.root()) == true);
+	assert(cursor.length() == 0);
+	assert(cursor.pop() == false);
+	test_cursor(cursor, trie, keys);
+
+	// Types keys and sometimes deletes labels or replaces the prefix.
+	test::Tools::KeysIterator key_it = keys.begin();
+	for (int i = 0; i < 1000; ++i)
+	{
+		std::advance(key_it, std::rand() % 64);
+		if (key_it == keys.end())
+			key_it = keys.begin();
+
+		const std::string &key = key_it->first;
+		switch (std::rand() % 4)
+		{
+		case 0:
+			assert(cursor.set_key(key.substr(0, 3).c_str()) == true);
+			break;
+		case 1:
+			{
+				bool is_empty = (cursor.length() == 0);
+				assert(cursor.pop() == !is_empty);
+			}
+			break;
+		case 2:
+			cursor.push(static_cast<char>('A' + (std::rand() % 27)));
+			break;
+		default:
+			if (key.compare(0, cursor.length(), cursor.key()) != 0)
+				assert(cursor.set_key("") == true);
+			for (std::size_t j = cursor.length(); j < key.length(); ++j)
+			{
+				assert(cursor.push(key[j]) == true);
+				test_cursor(cursor, trie, keys);
+			}
+			break;
+		}
+		test_cursor(cursor, trie, keys);
+		if (cursor.length() >= 6)
+			test_completion(cursor, keys);
+	}
+
+	assert(cursor.set_key("") == true);
+	assert(cursor.length() == 0);
+	assert(cursor.index() == trie.root());
+	test_cursor(cursor, trie, keys);
+
+	cursor.clear();
+}
+
+}  // namespace
+
+int main()
+{
+	test::Tools::KeysMap keys;
+	test::Tools::make_keys(&keys);
+
+	sumire::BasicTrie trie;
+	test::Tools::build_trie(keys, &trie);
+
+	test_trie<sumire::BasicTrie>(trie, keys);
+	test_trie<sumire::TernaryTrie>(trie, keys);
+	test_trie<sumire::DaTrie>(trie, keys);
+	test_trie<sumire::SuccinctTrie<> >(trie, keys);
+	test_trie<sumire::LoudsTrie<> >(trie, keys);
+	test_trie<sumire::LoudsPlusTrie<> >(trie, keys);
+	test_trie<sumire::PatriciaTrie<> >(trie, keys);
+	test_trie<sumire::HybridTrie<> >(trie, keys);
+
+	return 0;
+}
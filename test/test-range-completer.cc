@@ -0,0 +1,131 @@
+#include <sumire/trie-builder.h>
+#include <sumire/basic-trie.h>
+#include <sumire/ternary-trie.h>
+#include <sumire/da-trie.h>
+#include <sumire/succinct-trie.h>
+#include <sumire/hybrid-trie.h>
+#include <sumire/louds-plus-trie.h>
+#include <sumire/louds-trie.h>
+#include <sumire/patricia-trie.h>
+#include <sumire/range-completer.h>
+
+#include <iterator>
+
+#include "test-tools.h"
+
+namespace {
+
+void test_range(sumire::RangeCompleter *completer,
+	const test::Tools::KeysMap &keys, const std::string &lower_bound,
+	const std::string *upper_bound)
+{
+	completer->seek(lower_bound.c_str());
+	completer->set_upper_bound(
+		(upper_bound != NULL) ? upper_bound->c_str() : NULL);
+
+	test::Tools::KeysIterator key_it = keys.lower_bound(lower_bound);
+	test::Tools::KeysIterator end_it = (upper_bound != NULL) ?
+		keys.lower_bound(*upper_bound) : keys.end();
+	if (upper_bound != NULL && *upper_bound < lower_bound)
+		end_it = key_it;
+
+	while (completer->next())
+	{
+		assert(key_it != end_it);
+		assert(key_it->first == completer->key());
+		assert(key_it->first.length() == completer->length());
+		assert(key_it->second == completer->value());
+		++key_it;
+	}
+	assert(key_it == end_it);
+	assert(completer->next() == false);
+}
+
+std::string make_bound(const test::Tools::KeysMap &keys)
+{
+	test::Tools::KeysIterator it = keys.begin();
+	std::advance(it, std::rand() % keys.size());
+
+	std::string bound = it->first;
+	switch (std::rand() % 4)
+	{
+	case 0:
+		return bound;
+	case 1:
+		return bound.substr(0, std::rand() % bound.length());
+	case 2:
+		bound[std::rand() % bound.length()] = 'A' + (std::rand() % 27);
+		return bound;
+	default:
+		return bound + static_cast<char>('A' + (std::rand() % 26));
+	}
+}
+
+template <typename TRIE_TYPE>
+void test_trie(const sumire::TrieBase &basic_trie,
+	const test::Tools::KeysMap &keys)
+{
+	TRIE_TYPE trie;
+	trie.build(basic_trie);
+
+	sumire::RangeCompleter completer;
+	assert(completer.start(trie, trie.root()) == true);
+
+	test::Tools::KeysIterator key_it = keys.begin();
+	while (completer.next())
+	{
+		assert(key_it != keys.end());
+		assert(key_it->first == completer.key());
+		++key_it;
+	}
+	assert(key_it == keys.end());
+
+	test_range(&completer, keys, "", NULL);
+	test_range(&completer, keys, "\xFF", NULL);
+	test_range(&completer, keys, "", &keys.rbegin()->first);
+	for (int i = 0; i < 10; ++i)
+	{
+		std::string lower_bound = make_bound(keys);
+		std::string upper_bound = make_bound(keys);
+		test_range(&completer, keys, lower_bound, NULL);
+		test_range(&completer, keys, lower_bound, &upper_bound);
+	}
+
+	// Keys are relative to the start node.
+	const std::string &first_key = keys.begin()->first;
+	std::string prefix = first_key.substr(0, 2);
+	sumire::UInt32 index;
+	assert(trie.follow(trie.root(), prefix.c_str(), &index) == true);
+
+	test::Tools::KeysMap suffixes;
+	for (test::Tools::KeysIterator it = keys.lower_bound(prefix);
+		it != keys.end() && it->first.compare(0, 2, prefix) == 0; ++it)
+		suffixes.insert(std::make_pair(it->first.substr(2), it->second));
+
+	assert(completer.start(trie, index) == true);
+	std::string upper_bound = "M";
+	test_range(&completer, suffixes, first_key.substr(2), &upper_bound);
+	test_range(&completer, suffixes, "ZZZ", NULL);
+}
+
+}  // namespace
+
+int main()
+{
+	test::Tools::KeysMap keys;
+	test::Tools::make_keys(&keys);
+
+	sumire::BasicTrie trie;
+	test::Tools::build_trie(keys, &trie);
+
+	test_trie<sumire::BasicTrie>(trie, keys);
+	test_trie<sumire::TernaryTrie>(trie, keys);
+	test_trie<sumire::DaTrie>(trie, keys);
+	test_trie<sumire::SuccinctTrie<> >(trie, keys);
+	test_trie<sumire::LoudsTrie<> >(trie, keys);
+	test_trie<sumire::LoudsPlusTrie<> >(trie, keys);
+	test_trie<sumire::PatriciaTrie<> >(trie, keys);
+	test_trie<sumire::HybridTrie<> >(trie, keys);
+
+	return 0;
+}
@@ -4,6 +4,38 @@
 
 #include "test-tools.h"
 
+namespace {
+
+void convert_trie(const test::Tools::KeysMap &keys,
+	const sumire::TernaryTrie &src_trie)
+{
+	sumire::TernaryTrie trie;
+	assert(trie.build(src_trie,
+		sumire::TernaryTrie::PACKED_LABEL_LAYOUT) == true);
+
+	assert(trie.num_units() == src_trie.num_units());
+	assert(trie.num_keys() == keys.size());
+	assert(trie.size() == src_trie.size() + src_trie.num_units());
+
+	FIND_ALL_KEYS(trie, keys)
+
+	test::Tools::test_find_child(trie);
+	test::Tools::test_reload(trie, keys);
+	test::Tools::test_map(trie, keys);
+
+	// UNIT_LAYOUT writes units and the number of keys, and then
+	// PACKED_LABEL_LAYOUT appends labels.
+	std::stringstream unit_stream, packed_stream;
+	assert(src_trie.write(&unit_stream) == true);
+	assert(trie.write(&packed_stream) == true);
+	assert(unit_stream.str().length() ==
+		sizeof(sumire::UInt32) * 2 + src_trie.size());
+	assert(packed_stream.str().length() == unit_stream.str().length()
+		+ sizeof(sumire::UInt32) + src_trie.num_units());
+}
+
+}  // namespace
+
 int main()
 {
 	test::Tools::KeysMap keys;
@@ -11,6 +43,9 @@ int main()
 
 	sumire::TernaryTrie trie;
 	test::Tools::build_trie(keys, &trie);
+	test::Tools::test_find_child(trie);
+
+	convert_trie(keys, trie);
 
 	test::Tools::test_reload(trie, keys);
 	test::Tools::test_map(trie, keys);
@@ -68,6 +68,38 @@ public:
 		FIND_ALL_KEYS(*trie, keys)
 	}
 
+	template <typename TRIE_TYPE>
+	static void test_find_child(const TRIE_TYPE &trie)
+	{
+		// Nodes near the root have many children, and misses must stop at
+		// the end of each run of siblings.
+		std::vector<sumire::UInt32> indices(1, trie.root());
+		for (std::size_t i = 0; i < indices.size() && i < 4096; ++i)
+		{
+			sumire::UInt32 index = indices[i];
+			for (int label = 0; label < 256; ++label)
+			{
+				sumire::UInt32 expected = 0;
+				for (sumire::UInt32 child_index = trie.child(index);
+					child_index != 0;
+					child_index = trie.sibling(child_index))
+				{
+					if (trie.label(child_index) == label)
+					{
+						expected = child_index;
+						break;
+					}
+				}
+				assert(trie.find_child(index,
+					static_cast<sumire::UInt8>(label)) == expected);
+			}
+
+			for (sumire::UInt32 child_index = trie.child(index);
+				child_index != 0; child_index = trie.sibling(child_index))
+				indices.push_back(child_index);
+		}
+	}
+
 	template <typename TRIE_TYPE>
 	static void test_reload(const TRIE_TYPE &trie, const KeysMap &keys)
 	{
@@ -104,6 +136,69 @@ public:
 		assert(trie->num_keys() == 0);
 		assert(trie->size() == 0);
 	}
+
+	// Enumerates keys page by page, and each page is resumed from the saved
+	// state. Pages get longer and longer to keep the test short.
+	template <typename COMPLETER_TYPE, typename TRIE_TYPE>
+	static void test_resume(const TRIE_TYPE &trie)
+	{
+		COMPLETER_TYPE completer;
+		assert(completer.start(trie, trie.root()) == true);
+
+		COMPLETER_TYPE paged_completer;
+		assert(paged_completer.start(trie, trie.root()) == true);
+
+		std::stringstream stream;
+		std::size_t page_end = 0;
+		for (std::size_t i = 0; ; ++i)
+		{
+			if (i == page_end)
+			{
+				page_end = (i * 4) + 1;
+
+				stream.str("");
+				assert(paged_completer.save(&stream) == true);
+
+				COMPLETER_TYPE resumed_completer;
+				assert(resumed_completer.resume(trie, &stream) == true);
+				if (i != 0)
+				{
+					assert(std::string(resumed_completer.key()) ==
+						paged_completer.key());
+					assert(resumed_completer.value() ==
+						paged_completer.value());
+				}
+				paged_completer.clear();
+
+				stream.clear();
+				stream.seekg(0);
+				assert(paged_completer.resume(trie, &stream) == true);
+			}
+
+			if (!completer.next())
+				break;
+			assert(paged_completer.next() == true);
+			assert(std::string(paged_completer.key()) == completer.key());
+			assert(paged_completer.length() == completer.length());
+			assert(paged_completer.value() == completer.value());
+		}
+		assert(paged_completer.next() == false);
+
+		stream.str("");
+		assert(paged_completer.save(&stream) == true);
+		assert(paged_completer.resume(trie, &stream) == true);
+		assert(paged_completer.next() == false);
+
+		// A broken state is rejected.
+		assert(completer.start(trie, trie.root()) == true);
+		assert(completer.next() == true);
+		stream.str("");
+		stream.clear();
+		assert(completer.save(&stream) == true);
+		std::string state = stream.str();
+		stream.str(state.substr(0, state.length() - 1));
+		assert(completer.resume(trie, &stream) == false);
+	}
 };
 
 }  // namespace sumire
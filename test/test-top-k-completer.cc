@@ -0,0 +1,240 @@
+#include <sumire/trie-builder.h>
+#include <sumire/basic-trie.h>
+#include <sumire/ternary-trie.h>
+#include <sumire/da-trie.h>
+#include <sumire/succinct-trie.h>
+#include <sumire/hybrid-trie.h>
+#include <sumire/louds-plus-trie.h>
+#include <sumire/louds-trie.h>
+#include <sumire/patricia-trie.h>
+#include <sumire/top-k-cache.h>
+#include <sumire/top-k-completer.h>
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <sstream>
+
+#include "test-tools.h"
+
+namespace {
+
+// Checks that the results are the keys with the greatest values.
+void test_results(sumire::TopKCompleter *completer,
+	const test::Tools::KeysMap &keys, std::size_t max_num_results)
+{
+	std::vector<sumire::UInt32> values;
+	for (test::Tools::KeysIterator it = keys.begin(); it != keys.end(); ++it)
+		values.push_back(it->second);
+	std::sort(values.begin(), values.end(),
+		std::greater<sumire::UInt32>());
+	if (values.size() > max_num_results)
+		values.resize(max_num_results);
+
+	std::set<std::string> results;
+	while (completer->next())
+	{
+		test::Tools::KeysIterator it = keys.find(completer->key());
+		assert(it != keys.end());
+		assert(it->second == completer->value());
+		assert(completer->length() == it->first.length());
+
+		assert(results.size() < values.size());
+		assert(completer->value() == values[results.size()]);
+		assert(results.insert(completer->key()).second == true);
+	}
+	assert(results.size() == values.size());
+	assert(completer->next() == false);
+}
+
+template <typename TRIE_TYPE>
+void test_trie(const sumire::TrieBase &basic_trie,
+	const test::Tools::KeysMap &keys)
+{
+	TRIE_TYPE trie;
+	trie.build(basic_trie);
+
+	sumire::MaxValueTable max_values;
+	max_values.build(trie);
+	assert(max_values.num_units() == trie.num_units());
+	assert(max_values[trie.root()] == test::Tools::MAX_VALUE - 1);
+	assert(max_values.in_max_value_order() == false);
+
+	sumire::TopKCompleter completer;
+	assert(completer.start(trie, max_values, trie.root(), 10) == true);
+	test_results(&completer, keys, 10);
+
+	assert(completer.start(trie, max_values, trie.root(), 1000) == true);
+	test_results(&completer, keys, 1000);
+}
+
+void test_max_value_order(const sumire::BasicTrie &trie,
+	const test::Tools::KeysMap &keys)
+{
+	sumire::TopKCompleter completer;
+	assert(completer.start(trie, trie.root(), 10) == true);
+	test_results(&completer, keys, 10);
+
+	assert(completer.start(trie, trie.root()) == true);
+	test_results(&completer, keys, keys.size());
+
+	// Completes the keys that start with the first key.
+	const std::string &prefix = keys.begin()->first;
+	sumire::UInt32 index;
+	assert(trie.follow(trie.root(), prefix.c_str(), &index) == true);
+
+	test::Tools::KeysMap suffixes;
+	for (test::Tools::KeysIterator it = keys.begin(); it != keys.end(); ++it)
+	{
+		if (it->first.compare(0, prefix.length(), prefix) == 0)
+			suffixes.insert(std::make_pair(
+				it->first.substr(prefix.length()), it->second));
+	}
+
+	assert(completer.start(trie, index, 3) == true);
+	test_results(&completer, suffixes, 3);
+
+	// A table of the same trie lets siblings be added without sorting.
+	sumire::MaxValueTable max_values;
+	max_values.build(trie);
+	assert(max_values.in_max_value_order() == true);
+
+	assert(completer.start(trie, max_values, trie.root(), 10) == true);
+	test_results(&completer, keys, 10);
+
+	assert(completer.start(trie, max_values, trie.root(), 1000) == true);
+	test_results(&completer, keys, 1000);
+
+	assert(completer.start(trie, max_values, index, 3) == true);
+	test_results(&completer, suffixes, 3);
+}
+
+void test_max_value_table(const sumire::BasicTrie &trie)
+{
+	sumire::MaxValueTable max_values;
+	max_values.build(trie);
+
+	std::stringstream stream;
+	assert(max_values.write(&stream) == true);
+
+	sumire::MaxValueTable max_values_read;
+	assert(max_values_read.read(&stream) == true);
+	assert(max_values_read.size() == max_values.size());
+	assert(max_values_read.in_max_value_order() ==
+		max_values.in_max_value_order());
+	for (sumire::UInt32 index = 0; index < trie.num_units(); ++index)
+		assert(max_values_read[index] == max_values[index]);
+
+	std::string data = stream.str();
+	sumire::MaxValueTable max_values_mapped;
+	max_values_mapped.map(&data[0]);
+	assert(max_values_mapped.in_max_value_order() ==
+		max_values.in_max_value_order());
+	for (sumire::UInt32 index = 0; index < trie.num_units(); ++index)
+		assert(max_values_mapped[index] == max_values[index]);
+
+	max_values.clear();
+	assert(max_values.size() == 0);
+}
+
+void test_cache(const sumire::BasicTrie &trie,
+	const test::Tools::KeysMap &keys)
+{
+	sumire::TopKCache cache;
+	cache.build(trie, 10, 50);
+
+	assert(cache.num_results() == 10);
+	assert(cache.num_nodes() > 1);
+
+	sumire::UInt32 id;
+	assert(cache.find(trie.root(), &id) == true);
+	assert(cache.result_end(id) - cache.result_begin(id) == 10);
+
+	sumire::TopKCompleter completer;
+	assert(completer.start(trie, trie.root(), 10, &cache) == true);
+	test_results(&completer, keys, 10);
+
+	assert(completer.start(trie, trie.root(), 5, &cache) == true);
+	test_results(&completer, keys, 5);
+
+	// The cache does not have enough results, and the trie is traversed.
+	assert(completer.start(trie, trie.root(), 20, &cache) == true);
+	test_results(&completer, keys, 20);
+
+	const std::string &key = keys.begin()->first;
+	for (std::size_t length = 1; length <= 2; ++length)
+	{
+		std::string prefix = key.substr(0, length);
+		sumire::UInt32 index;
+		assert(trie.follow(trie.root(), prefix.c_str(), &index) == true);
+
+		test::Tools::KeysMap suffixes;
+		for (test::Tools::KeysIterator it = keys.begin();
+			it != keys.end(); ++it)
+		{
+			if (it->first.compare(0, prefix.length(), prefix) == 0)
+				suffixes.insert(std::make_pair(
+					it->first.substr(prefix.length()), it->second));
+		}
+
+		if (suffixes.size() >= 50)
+			assert(cache.find(index, &id) == true);
+
+		assert(completer.start(trie, index, 10, &cache) == true);
+		test_results(&completer, suffixes, 10);
+	}
+
+	std::stringstream stream;
+	assert(cache.write(&stream) == true);
+
+	sumire::TopKCache cache_read;
+	assert(cache_read.read(&stream) == true);
+	assert(cache_read.num_nodes() == cache.num_nodes());
+	assert(cache_read.size() == cache.size());
+
+	assert(completer.start(trie, trie.root(), 10, &cache_read) == true);
+	test_results(&completer, keys, 10);
+
+	std::string data = stream.str();
+	sumire::TopKCache cache_mapped;
+	cache_mapped.map(&data[0]);
+	assert(cache_mapped.num_results() == cache.num_results());
+	assert(cache_mapped.size() == cache.size());
+
+	assert(completer.start(trie, trie.root(), 10, &cache_mapped) == true);
+	test_results(&completer, keys, 10);
+
+	cache.clear();
+	assert(cache.num_nodes() == 0);
+	assert(cache.size() == 0);
+}
+
+}  // namespace
+
+int main()
+{
+	test::Tools::KeysMap keys;
+	test::Tools::make_keys(&keys);
+
+	sumire::BasicTrie trie;
+	test::Tools::build_trie(keys, &trie);
+
+	// MaxValueTable works with siblings in any order.
+	test_trie<sumire::BasicTrie>(trie, keys);
+	test_trie<sumire::TernaryTrie>(trie, keys);
+	test_trie<sumire::DaTrie>(trie, keys);
+	test_trie<sumire::SuccinctTrie<> >(trie, keys);
+	test_trie<sumire::LoudsTrie<> >(trie, keys);
+	test_trie<sumire::LoudsPlusTrie<> >(trie, keys);
+	test_trie<sumire::PatriciaTrie<> >(trie, keys);
+	test_trie<sumire::HybridTrie<> >(trie, keys);
+
+	test_max_value_table(trie);
+
+	trie.build(trie, sumire::BasicTrie::MAX_VALUE_ORDER);
+
+	test_max_value_order(trie, keys);
+	test_cache(trie, keys);
+
+	return 0;
+}
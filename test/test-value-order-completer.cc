@@ -3,8 +3,10 @@
 #include <sumire/ternary-trie.h>
 #include <sumire/da-trie.h>
 #include <sumire/succinct-trie.h>
+#include <sumire/hybrid-trie.h>
 #include <sumire/louds-plus-trie.h>
 #include <sumire/louds-trie.h>
+#include <sumire/patricia-trie.h>
 #include <sumire/value-order-completer.h>
 
 #include "test-tools.h"
@@ -41,6 +43,7 @@ void test_trie(const sumire::TrieBase &basic_trie,
 	FIND_ALL_KEYS(trie, keys);
 
 	test_completer(trie, keys);
+	test::Tools::test_resume<sumire::ValueOrderCompleter>(trie);
 }
 
 }  // namespace
@@ -61,6 +64,8 @@ int main()
 	test_trie<sumire::SuccinctTrie<> >(trie, keys);
 	test_trie<sumire::LoudsTrie<> >(trie, keys);
 	test_trie<sumire::LoudsPlusTrie<> >(trie, keys);
+	test_trie<sumire::PatriciaTrie<> >(trie, keys);
+	test_trie<sumire::HybridTrie<> >(trie, keys);
 
 	return 0;
 }
@@ -0,0 +1,98 @@
+#include <sumire/word-select.h>
+
+#include <cassert>
+#include <cstdlib>
+#include <ctime>
+
+namespace {
+
+const int NUM_RANDOM_WORDS = 1 << 14;
+
+template <typename UNIT_TYPE>
+UNIT_TYPE make_random_word()
+{
+	UNIT_TYPE unit = 0;
+	for (std::size_t i = 0; i < sizeof(UNIT_TYPE); ++i)
+		unit = (unit << 8) | static_cast<UNIT_TYPE>(std::rand() & 0xFF);
+	return unit;
+}
+
+// Returns a random word whose density of 1s depends on the number of
+// words merged by AND or OR.
+template <typename UNIT_TYPE>
+UNIT_TYPE make_word()
+{
+	UNIT_TYPE unit = make_random_word<UNIT_TYPE>();
+	int num_merges = std::rand() % 4;
+	bool is_sparse = (std::rand() % 2) == 0;
+	for (int i = 0; i < num_merges; ++i)
+	{
+		if (is_sparse)
+			unit &= make_random_word<UNIT_TYPE>();
+		else
+			unit |= make_random_word<UNIT_TYPE>();
+	}
+	return unit;
+}
+
+template <typename UNIT_TYPE>
+void check_word(UNIT_TYPE unit)
+{
+	const sumire::UInt32 NUM_BITS = sizeof(UNIT_TYPE) * 8;
+
+	// Every count is checked against a naive scan.
+	sumire::UInt32 num_ones = 0;
+	sumire::UInt32 num_zeros = 0;
+	for (sumire::UInt32 i = 0; i < NUM_BITS; ++i)
+	{
+		if ((unit >> i) & 1)
+		{
+			++num_ones;
+			assert(sumire::WordSelect::select_1(unit, num_ones) == i);
+		}
+		else
+		{
+			++num_zeros;
+			assert(sumire::WordSelect::select_0(unit, num_zeros) == i);
+		}
+	}
+	assert(num_ones + num_zeros == NUM_BITS);
+}
+
+template <typename UNIT_TYPE>
+void test_words()
+{
+	const sumire::UInt32 NUM_BITS = sizeof(UNIT_TYPE) * 8;
+
+	check_word<UNIT_TYPE>(0);
+	check_word<UNIT_TYPE>(~static_cast<UNIT_TYPE>(0));
+	for (sumire::UInt32 i = 0; i < NUM_BITS; ++i)
+	{
+		check_word<UNIT_TYPE>(static_cast<UNIT_TYPE>(1) << i);
+		check_word<UNIT_TYPE>(~(static_cast<UNIT_TYPE>(1) << i));
+		check_word<UNIT_TYPE>(~static_cast<UNIT_TYPE>(0) << i);
+		check_word<UNIT_TYPE>(~static_cast<UNIT_TYPE>(0) >> i);
+	}
+
+	for (int i = 0; i < NUM_RANDOM_WORDS; ++i)
+		check_word(make_word<UNIT_TYPE>());
+}
+
+}  // namespace
+
+int main()
+{
+#ifdef __BMI2__
+	// The PDEP path is tested only on a CPU that supports it.
+	__builtin_cpu_init();
+	if (!__builtin_cpu_supports("bmi2"))
+		return 0;
+#endif  // __BMI2__
+
+	std::srand(static_cast<unsigned>(std::time(NULL)));
+
+	test_words<sumire::UInt32>();
+	test_words<sumire::UInt64>();
+
+	return 0;
+}